@@ -0,0 +1,640 @@
+#include "assembler.h"
+
+#include <algorithm>
+#include <cctype>  // toupper()
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "parallelScan.h"
+#include "scanner.h"
+#include "threadPool.h"
+using namespace std;
+
+// Scans every line of text separately, splitting lines the same way as
+// Assembler::getNextLine.
+static vector<ScannedLine> scanLines(string_view text) {
+  vector<ScannedLine> lines;
+  while (!text.empty()) {
+    size_t newline = text.find('\n');
+    string_view line = text.substr(0, newline);
+    text.remove_prefix(newline == string_view::npos ? text.size()
+                                                    : newline + 1);
+    lines.emplace_back();
+    try {
+      lines.back().tokens = scan(line);
+    } catch (ScanningFailure &f) {
+      lines.back().error = f.what();
+    }
+  }
+  return lines;
+}
+
+const int Assembler::alignedAccessMultiplier = 4;
+
+Assembler::Assembler(string_view source, size_t numThreads, bool merl,
+                     ostream &err)
+    : compilationSucceeded(true),
+      source(source),
+      sourcePosn(0),
+      sourceExhausted(false),
+      numThreads(numThreads),
+      merl(merl),
+      err(err),
+      nextScannedLine(0) {}
+
+Assembler::~Assembler() {}
+
+bool Assembler::assemble() {
+  if (scanning()) {
+    if (parsing()) {
+      if (linkage()) {
+        if (semanticAnalysis()) {
+          if (synthesis()) {
+            if (merl) {
+              outMerl();
+            }
+            return compilationSucceeded;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+void Assembler::scanningError(string message) {
+  err << "ERROR: ScanningFailure" << endl;
+  err << message << endl;
+  compilationSucceeded = false;
+}
+
+void Assembler::parseError(int lineNumber, string message) {
+  parseError(programList[lineNumber], message);
+}
+
+void Assembler::parseError(const vector<Token> &line, string message) {
+  err << "ERROR: Parse Error in line: ";
+  for (auto &token : line) {
+    err << token << ' ';
+  }
+  err << endl;
+  err << message << endl;
+  compilationSucceeded = false;
+}
+
+void Assembler::semanticError(int lineNumber, string message) {
+  semanticError(programList[lineNumber], message);
+}
+
+void Assembler::semanticError(const vector<Token> &line, string message) {
+  err << "ERROR: Semantic Error in line: ";
+  for (auto &token : line) {
+    err << token << ' ';
+  }
+  err << endl;
+  err << message << endl;
+  compilationSucceeded = false;
+}
+
+bool Assembler::moreInputRemains() const { return !sourceExhausted; }
+
+// Behaves like getline on the source buffer, including when it reports the
+// end of input, but hands out a view instead of copying the line.
+bool Assembler::getNextLine(string_view &line) {
+  if (sourcePosn >= source.size()) {
+    sourceExhausted = true;
+    return false;
+  }
+
+  string_view rest = source.substr(sourcePosn);
+  size_t newline = rest.find('\n');
+  if (newline == string_view::npos) {
+    line = rest;
+    sourcePosn = source.size();
+    sourceExhausted = true;
+  } else {
+    line = rest.substr(0, newline);
+    sourcePosn += newline + 1;
+  }
+  return true;
+}
+
+void Assembler::outInstruction(int i) {
+  out += char(i >> 24);
+  out += char(i >> 16);
+  out += char(i >> 8);
+  out += char(i);
+}
+
+void Assembler::outMerl() {
+  string code = std::move(out);
+  out.clear();
+
+  int endCode = 12 + code.size();
+  int endModule = endCode;
+  for (const MerlEntry &entry : merlTable) {
+    endModule += entry.type == REL ? 8 : 12 + 4 * entry.name.size();
+  }
+
+  mips_beq(0, 0, 2);  // the MERL cookie, 0x10000002, skips the header
+  mips_dotword(endModule);
+  mips_dotword(endCode);
+  out += code;
+  for (const MerlEntry &entry : merlTable) {
+    mips_dotword(entry.type);
+    mips_dotword(entry.location);
+    if (entry.type != REL) {
+      mips_dotword(entry.name.size());
+      for (char c : entry.name) {
+        mips_dotword(c);
+      }
+    }
+  }
+}
+
+void Assembler::mips_add(int d, int s, int t) {
+  outInstruction((s << 21) | (t << 16) | (d << 11) | 32);
+}
+void Assembler::mips_sub(int d, int s, int t) {
+  outInstruction((s << 21) | (t << 16) | (d << 11) | 34);
+}
+void Assembler::mips_slt(int d, int s, int t) {
+  outInstruction((s << 21) | (t << 16) | (d << 11) | 42);
+}
+void Assembler::mips_sltu(int d, int s, int t) {
+  outInstruction((s << 21) | (t << 16) | (d << 11) | 43);
+}
+
+void Assembler::mips_beq(int s, int t, uint16_t i) {
+  outInstruction(0x10000000 | (s << 21) | (t << 16) | i);
+}  // use uint16_t truncate the int
+void Assembler::mips_bne(int s, int t, uint16_t i) {
+  outInstruction(0x14000000 | (s << 21) | (t << 16) | i);
+}
+
+void Assembler::mips_lis(int d) { outInstruction((d << 11) | 20); }
+void Assembler::mips_mflo(int d) { outInstruction((d << 11) | 18); }
+void Assembler::mips_mfhi(int d) { outInstruction((d << 11) | 16); }
+
+void Assembler::mips_mult(int s, int t) {
+  outInstruction((s << 21) | (t << 16) | 24);
+}
+void Assembler::mips_multu(int s, int t) {
+  outInstruction((s << 21) | (t << 16) | 25);
+}
+void Assembler::mips_div(int s, int t) {
+  outInstruction((s << 21) | (t << 16) | 26);
+}
+void Assembler::mips_divu(int s, int t) {
+  outInstruction((s << 21) | (t << 16) | 27);
+}
+
+void Assembler::mips_lw(int t, uint16_t i, int s) {
+  outInstruction(0x8c000000 | (s << 21) | (t << 16) | i);
+}
+void Assembler::mips_sw(int t, uint16_t i, int s) {
+  outInstruction(0xac000000 | (s << 21) | (t << 16) | i);
+}
+
+void Assembler::mips_jr(int s) { outInstruction((s << 21) | 8); }
+void Assembler::mips_jalr(int s) { outInstruction((s << 21) | 9); }
+
+void Assembler::mips_dotword(int s) { outInstruction(s); }
+
+bool Assembler::scanning() {
+  // Lines are independent, so they can be scanned in any order. Errors are
+  // only reported below, as the lines are reached, to keep them in order.
+  if (numThreads > 1) {
+    ThreadPool pool(numThreads);
+    scannedLines = parallelScan<ScannedLine>(source, pool, scanLines);
+  } else {
+    scannedLines = scanLines(source);
+  }
+
+  while (moreInputRemains()) {
+    vector<Token> tokenLine{};
+
+    vector<Token> temp = tokenizeNextLine();
+    while (moreInputRemains() && temp.size() &&
+           temp.back().getKind() == Token::LABEL) {
+      tokenLine.insert(tokenLine.end(), temp.begin(), temp.end());
+      temp = tokenizeNextLine();
+    }
+    tokenLine.insert(tokenLine.end(), temp.begin(), temp.end());
+
+    // .import and .export take no space, so they are kept apart from the
+    // instructions, whose indices are their addresses.
+    if (tokenLine.size() && (tokenLine[0].getKind() == Token::IMPORT ||
+                             tokenLine[0].getKind() == Token::EXPORT)) {
+      if (!merl) {
+        scanningError("ERROR: " + string(tokenLine[0].getLexeme()) +
+                      " is only allowed in MERL output");
+        continue;
+      }
+      directiveList.push_back(tokenLine);
+    } else if (tokenLine.size()) {
+      programList.push_back(tokenLine);
+    }
+  }
+
+  return true;
+}
+
+bool Assembler::parsing() {
+  // handle label
+  for (int i = 0; i < int(programList.size()); i++) {
+    size_t labelCount = 0;
+    while (programList[i].size() > labelCount &&
+           programList[i][labelCount].getKind() == Token::LABEL) {
+      if (!recordLabel(programList[i][labelCount], i)) {
+        parseError(i, "Duplicate symbol: " +
+                          string(programList[i][0].getLexeme()));
+        return false;
+      }
+      labelCount++;
+    }
+
+    if (labelCount > 0) {
+      programList[i].erase(programList[i].begin(),
+                           programList[i].begin() + labelCount);
+      if (programList.back().size() == 0) {  // handle a line full of label
+        programList.pop_back();
+      }
+    }
+  }
+
+  // handle syntax
+  for (int i = 0; i < int(programList.size()); i++) {
+    Token frontToken = programList[i][0];
+    if (frontToken.getKind() == Token::ID) {
+      if (frontToken.getLexeme() == "add" || frontToken.getLexeme() == "sub" ||
+          frontToken.getLexeme() == "slt" || frontToken.getLexeme() == "sltu") {
+        if (!checkRegCommaRegCommaReg(i)) {
+          parseError(
+              i,
+              "Expecting a valid add, sub, slt, or sltu with valid register");
+          return false;
+        }
+      } else if (frontToken.getLexeme() == "mult" ||
+                 frontToken.getLexeme() == "multu" ||
+                 frontToken.getLexeme() == "div" ||
+                 frontToken.getLexeme() == "divu") {
+        if (!checkRegCommaReg(i)) {
+          parseError(i,
+                     "Expecting a valid mult, multu, div, or divu with valid "
+                     "register");
+          return false;
+        }
+      } else if (frontToken.getLexeme() == "mfhi" ||
+                 frontToken.getLexeme() == "mflo" ||
+                 frontToken.getLexeme() == "lis") {
+        if (!checkReg(i)) {
+          parseError(
+              i, "Expecting a valid mfhi, mflo, or lis with valid register");
+          return false;
+        }
+      } else if (frontToken.getLexeme() == "lw" ||
+                 frontToken.getLexeme() == "sw") {
+        if (!checkRegCommaIntLparenRegRparen(i)) {
+          parseError(i,
+                     "Expecting a valid lw, or sw with valid register and "
+                     "address reference");
+          return false;
+        }
+      } else if (frontToken.getLexeme() == "beq" ||
+                 frontToken.getLexeme() == "bne") {
+        if (!checkRegCommaRegCommaTop(i)) {
+          parseError(i,
+                     "Expecting a valid beq, or bne with valid register and "
+                     "address reference");
+          return false;
+        }
+      } else if (frontToken.getLexeme() == "jr" ||
+                 frontToken.getLexeme() == "jalr") {
+        if (!checkReg(i)) {
+          parseError(i, "Expecting a valid jr, or jalr with valid register");
+          return false;
+        }
+      } else {
+        parseError(i, "Expecting opcode, label, or directive");
+        return false;
+      }
+    } else if (frontToken.getKind() == Token::WORD) {
+      if (!checkWord(i)) {
+        parseError(i,
+                   "Expecting valid .word with a valid int, hexint, label, or "
+                   "address");
+        return false;
+      }
+    } else {
+      parseError(i, "Expecting opcode, label, or directive");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Assembler::linkage() {
+  for (auto &line : directiveList) {
+    if (line.size() != 2 || line[1].getKind() != Token::ID) {
+      parseError(line, "Expecting a valid .import or .export with a label");
+      return false;
+    }
+    string_view name = line[1].getLexeme();
+    if (line[0].getKind() == Token::IMPORT) {
+      if (labelTable.count(name)) {
+        parseError(line, "Duplicate symbol: " + string(name));
+        return false;
+      }
+      imports.insert(name);
+    } else {
+      if (!labelTable.count(name)) {
+        semanticError(line, ".export referenced a nonexisting label");
+        return false;
+      }
+      merlTable.push_back(
+          MerlEntry{ESD, uint32_t(addressOf(labelTable[name])), name});
+    }
+  }
+  return true;
+}
+
+int Assembler::addressOf(int i) const {
+  return (merl ? 12 : 0) + i * alignedAccessMultiplier;
+}
+
+bool Assembler::semanticAnalysis() {
+  for (int i = 0; i < int(programList.size()); i++) {
+    Token frontToken = programList[i][0];
+    // check beq, bne, .word and replace their id label with address
+    if (frontToken.getLexeme() == "beq" || frontToken.getLexeme() == "bne") {
+      Token token5 = programList[i][5];
+      if (token5.getKind() == Token::ID) {
+        if (labelTable.find(token5.getLexeme()) != labelTable.end()) {
+          int move = labelTable[programList[i][5].getLexeme()] - i - 1;
+          if (move >= -32768 && move <= 32767) {
+            programList[i][5] = Token(Token::INT, int64_t(move));
+          } else {
+            semanticError(i, "Bne, Beq label address out of bounds");
+            return false;
+          }
+        } else {
+          semanticError(i, "Bne or Beq referenced a nonexisting label");
+          return false;
+        }
+      }
+    } else if (frontToken.getKind() == Token::WORD) {
+      Token token1 = programList[i][1];
+      if (token1.getKind() == Token::ID) {
+        if (labelTable.find(token1.getLexeme()) != labelTable.end()) {
+          // If a label is used for i, its value is encoded as an unsigned
+          // 32-bit integer. Although this technically imposes a limit on the
+          // maximum value of a label operand for .word, MIPS assemblers are not
+          // required to enforce this limit, since a program several gigabytes
+          // in size would be needed to reach it. we replace with the actual
+          // (index*4), which in a MERL module is relocated by the loader
+          programList[i][1] = Token(
+              Token::INT, int64_t(addressOf(labelTable[token1.getLexeme()])));
+          if (merl) {
+            merlTable.push_back(MerlEntry{REL, uint32_t(addressOf(i)), ""});
+          }
+        } else if (imports.count(token1.getLexeme())) {
+          // filled in by the linker
+          programList[i][1] = Token(Token::INT, int64_t(0));
+          merlTable.push_back(
+              MerlEntry{ESR, uint32_t(addressOf(i)), token1.getLexeme()});
+        } else {
+          semanticError(i, ".word refereced a nonexisting label");
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool Assembler::synthesis() {
+  for (int i = 0; i < int(programList.size()); i++) {
+    Token frontToken = programList[i][0];
+    if (frontToken.getKind() == Token::ID) {
+      if (frontToken.getLexeme() == "add") {
+        mips_add(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                 programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "sub") {
+        mips_sub(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                 programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "slt") {
+        mips_slt(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                 programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "sltu") {
+        mips_sltu(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                  programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "mult") {
+        mips_mult(programList[i][1].toNumber(), programList[i][3].toNumber());
+      } else if (frontToken.getLexeme() == "multu") {
+        mips_multu(programList[i][1].toNumber(), programList[i][3].toNumber());
+      } else if (frontToken.getLexeme() == "div") {
+        mips_div(programList[i][1].toNumber(), programList[i][3].toNumber());
+      } else if (frontToken.getLexeme() == "divu") {
+        mips_divu(programList[i][1].toNumber(), programList[i][3].toNumber());
+      } else if (frontToken.getLexeme() == "mfhi") {
+        mips_mfhi(programList[i][1].toNumber());
+      } else if (frontToken.getLexeme() == "mflo") {
+        mips_mflo(programList[i][1].toNumber());
+      } else if (frontToken.getLexeme() == "lis") {
+        mips_lis(programList[i][1].toNumber());
+      } else if (frontToken.getLexeme() == "lw") {
+        mips_lw(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "sw") {
+        mips_sw(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "beq") {
+        mips_beq(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                 programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "bne") {
+        mips_bne(programList[i][1].toNumber(), programList[i][3].toNumber(),
+                 programList[i][5].toNumber());
+      } else if (frontToken.getLexeme() == "jr") {
+        mips_jr(programList[i][1].toNumber());
+      } else if (frontToken.getLexeme() == "jalr") {
+        mips_jalr(programList[i][1].toNumber());
+      } else {
+        return false;
+      }
+    } else if (frontToken.getKind() == Token::WORD) {
+      mips_dotword(programList[i][1].toNumber());
+    }
+  }
+  return true;
+}
+
+bool Assembler::checkRegCommaRegCommaReg(int lineNumber) {
+  if (programList[lineNumber].size() != 6) {
+    return false;
+  }
+
+  Token token1 = programList[lineNumber][1];
+  Token token2 = programList[lineNumber][2];
+  Token token3 = programList[lineNumber][3];
+  Token token4 = programList[lineNumber][4];
+  Token token5 = programList[lineNumber][5];
+
+  if (isValidReg(token1) && token2.getKind() == Token::COMMA &&
+      isValidReg(token3) && token4.getKind() == Token::COMMA &&
+      isValidReg(token5)) {
+    return true;
+  }
+
+  return false;
+}
+
+bool Assembler::checkRegCommaReg(int lineNumber) {
+  if (programList[lineNumber].size() != 4) {
+    return false;
+  }
+
+  Token token1 = programList[lineNumber][1];
+  Token token2 = programList[lineNumber][2];
+  Token token3 = programList[lineNumber][3];
+
+  if (isValidReg(token1) && token2.getKind() == Token::COMMA &&
+      isValidReg(token3)) {
+    return true;
+  }
+  return false;
+}
+
+bool Assembler::checkReg(int lineNumber) {
+  if (programList[lineNumber].size() != 2) {
+    return false;
+  }
+
+  Token token1 = programList[lineNumber][1];
+
+  if (isValidReg(token1)) {
+    return true;
+  }
+  return false;
+}
+
+bool Assembler::checkRegCommaIntLparenRegRparen(int lineNumber) {
+  if (programList[lineNumber].size() != 7) {
+    return false;
+  }
+
+  Token token1 = programList[lineNumber][1];
+  Token token2 = programList[lineNumber][2];
+  Token token3 = programList[lineNumber][3];
+  Token token4 = programList[lineNumber][4];
+  Token token5 = programList[lineNumber][5];
+  Token token6 = programList[lineNumber][6];
+
+  if (isValidReg(token1) && token2.getKind() == Token::COMMA &&
+      isValid16sSigned(token3) && token4.getKind() == Token::LPAREN &&
+      isValidReg(token5) && token6.getKind() == Token::RPAREN) {
+    return true;
+  }
+  return false;
+}
+
+bool Assembler::checkRegCommaRegCommaTop(int lineNumber) {
+  if (programList[lineNumber].size() != 6) {
+    return false;
+  }
+
+  Token token1 = programList[lineNumber][1];
+  Token token2 = programList[lineNumber][2];
+  Token token3 = programList[lineNumber][3];
+  Token token4 = programList[lineNumber][4];
+  Token token5 = programList[lineNumber][5];
+
+  if (isValidReg(token1) && token2.getKind() == Token::COMMA &&
+      isValidReg(token3) && token4.getKind() == Token::COMMA) {
+    if (token5.getKind() == Token::INT || token5.getKind() == Token::HEXINT) {
+      if (isValid16sSigned(token5)) {
+        return true;
+      }
+    } else if (token5.getKind() == Token::ID) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Assembler::checkWord(int lineNumber) {
+  if (programList[lineNumber].size() != 2) {
+    return false;
+  }
+  Token token0 = programList[lineNumber][0];
+  Token token1 = programList[lineNumber][1];
+  if (token0.getKind() != Token::WORD) {
+    return false;
+  }
+
+  if (token1.getKind() == Token::INT && token1.toNumber() >= -pow(2, 31) &&
+      token1.toNumber() <= pow(2, 32) - 1) {
+    return true;
+  } else if (token1.getKind() == Token::HEXINT &&
+             token1.toNumber() <= 0xffffffff) {
+    return true;
+  } else if (token1.getKind() == Token::ID) {
+    return true;
+  }
+
+  return false;
+}
+
+bool Assembler::isValidReg(Token token) {
+  if (token.getKind() == Token::REG && token.toNumber() >= 0 &&
+      token.toNumber() <= 31) {
+    return true;
+  }
+  return false;
+}
+
+bool Assembler::isValid16sSigned(Token token) {
+  if (token.getKind() == Token::INT && token.toNumber() >= -32768 &&
+      token.toNumber() <= 32767) {
+    return true;
+  } else if (token.getKind() == Token::HEXINT && token.toNumber() <= 0xffff) {
+    return true;
+  }
+  return false;
+}
+
+vector<Token> Assembler::tokenizeNextLine() {
+  string_view line;
+  vector<Token> tokenLine{};
+  while (tokenLine.size() == 0 && getNextLine(line)) {
+    ScannedLine &scanned = scannedLines[nextScannedLine++];
+    if (!scanned.error.empty()) {
+      scanningError(scanned.error);
+      return {};
+    }
+    tokenLine = std::move(scanned.tokens);
+  }
+  return tokenLine;
+}
+
+bool Assembler::recordLabel(Token label, int lineNumber) {
+  string_view lexeme = label.getLexeme();
+  lexeme.remove_suffix(1);  // remove the colon at the end
+
+  if (labelTable.find(lexeme) != labelTable.end()) {
+    return false;
+  }
+  labelTable[lexeme] =
+      lineNumber;  // programList index corresponds to the index, size =
+                   // maxIndex + 1 corresponds to the newLine index
+
+  return true;
+}
@@ -0,0 +1,151 @@
+#ifndef ASSEMBLER_H
+#define ASSEMBLER_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "scanner.h"
+
+// The tokens of one source line, or the message of the ScanningFailure it
+// raised.
+struct ScannedLine {
+  std::vector<Token> tokens;
+  std::string error;
+};
+
+/*
+ * Two-pass MIPS assembler, used by asm and by wlp4c.
+ *
+ * The program is taken as one buffer, which must outlive the assembler: every
+ * Token and label name is a view into it. Errors are reported on err,
+ * std::cerr unless given, as they are found, in the order of the lines they
+ * are on.
+ *
+ * By default the output is the raw machine code, as for cs241.binasm. With
+ * merl set it is a MERL object module instead, as for cs241.linkasm: the
+ * code follows a three-word header, so labels are 12 bytes further on, the
+ * .import and .export directives are allowed, and a footer records where
+ * .word uses a label (REL), an imported name (ESR), and what is exported
+ * (ESD).
+ */
+class Assembler {
+ public:
+  virtual ~Assembler();
+  // Returns whether the program assembled without errors.
+  virtual bool assemble();
+  // With numThreads > 1 the lines are scanned in parallel chunks first.
+  explicit Assembler(std::string_view source, size_t numThreads = 1,
+                     bool merl = false, std::ostream &err = std::cerr);
+
+  // The machine code or MERL module, once assemble() has run.
+  const std::string &output() const { return out; }
+
+  // Useful constants
+  static const int alignedAccessMultiplier;
+
+ protected:
+ private:
+  /* Pass 1 */
+  // scan and tokenize the program
+  bool scanning();
+  // parse label table and check for syntax and valid label usage
+  bool parsing();
+  // check .import and .export against the label table
+  bool linkage();
+
+  /* Pass 2 */
+  // replace label with address reference
+  bool semanticAnalysis();
+  bool synthesis();
+
+  /* Pass 1 Helper */
+  bool recordLabel(Token tokenLine, int lineNumber);
+
+  bool checkRegCommaRegCommaReg(int line);  // add, sub, slt, sltu
+  bool checkRegCommaReg(int line);          // mult, multu, div, divu
+  bool checkReg(int line);                  // mfhi, mflo, lis   , jr, jalr
+  bool checkRegCommaIntLparenRegRparen(int line);  // lw, sw
+  bool checkRegCommaRegCommaTop(int line);         // beq, bne
+
+  bool checkWord(int line);
+
+  bool isValidReg(Token token);
+  bool isValid16sSigned(Token token);
+
+  /* Output */
+  void outInstruction(
+      int i);  // output one line of instruction in unsigned char
+  void outMerl();  // wrap the code in a MERL header and footer
+
+  void mips_add(int d, int s, int t);
+  void mips_sub(int d, int s, int t);
+  void mips_slt(int d, int s, int t);
+  void mips_sltu(int d, int s, int t);
+
+  void mips_beq(int s, int t, uint16_t i);
+  void mips_bne(int s, int t, uint16_t i);
+
+  void mips_lis(int d);
+  void mips_mflo(int d);
+  void mips_mfhi(int d);
+  void mips_mult(int s, int t);
+  void mips_multu(int s, int t);
+  void mips_div(int s, int t);
+  void mips_divu(int s, int t);
+
+  void mips_lw(int t, uint16_t i, int s);
+  void mips_sw(int t, uint16_t i, int s);
+
+  void mips_jr(int s);
+  void mips_jalr(int s);
+
+  void mips_dotword(int s);
+
+  /* Error */
+  void scanningError(std::string message);
+  void parseError(int lineNumber, std::string message);
+  void parseError(const std::vector<Token> &line, std::string message);
+  void semanticError(int lineNumber, std::string message);
+  void semanticError(const std::vector<Token> &line, std::string message);
+
+  /* Util */
+  bool moreInputRemains() const;  // not virtual
+  bool getNextLine(std::string_view &line);
+  std::vector<Token> tokenizeNextLine();
+  // The address of the instruction at index i of programList.
+  int addressOf(int i) const;
+  bool compilationSucceeded;
+  // The whole program; every Token and label name is a view into it.
+  std::string_view source;
+  size_t sourcePosn;
+  bool sourceExhausted;
+  size_t numThreads;
+  bool merl;
+  std::ostream &err;
+  // Every line of the source scanned up front, indexed like getNextLine
+  std::vector<ScannedLine> scannedLines;
+  size_t nextScannedLine;
+  std::vector<std::vector<Token>> programList;
+  // map label name to line index
+  std::unordered_map<std::string_view, int> labelTable;
+
+  /* MERL */
+  struct MerlEntry {
+    uint32_t type;  // REL, ESD or ESR
+    uint32_t location;
+    std::string_view name;  // empty for REL
+  };
+  static const uint32_t REL = 0x01, ESD = 0x05, ESR = 0x11;
+  std::vector<std::vector<Token>> directiveList;  // .import and .export lines
+  std::unordered_set<std::string_view> imports;
+  std::vector<MerlEntry> merlTable;
+
+  std::string out;
+};
+
+#endif
@@ -1,16 +1,19 @@
 #include <sstream>
 #include <iomanip>
 #include <cctype>
+#include <charconv>
 #include <algorithm>
+#include <limits>
 #include <utility>
-#include <set>
 #include <array>
 #include "scanner.h"
+#include "dfaTable.h"
+#include "scanSimd.h"
 
 /*
  * C++ Starter code for CS241 A3
- * All code requires C++14, so if you're getting compile errors make sure to
- * use -std=c++14.
+ * All code requires C++17, so if you're getting compile errors make sure to
+ * use -std=c++17.
  *
  * This file contains helpers for asm.cc and you don't need to modify it.
  * Read the scanner.h file for a description of the helper functions.
@@ -20,11 +23,14 @@
  * to write the assembler.
  */
 
-Token::Token(Token::Kind kind, std::string lexeme):
-  kind(kind), lexeme(std::move(lexeme)) {}
+Token::Token(Token::Kind kind, std::string_view lexeme):
+  kind(kind), lexeme(lexeme), resolved(false), value(0) {}
 
-  Token:: Kind Token::getKind() const { return kind; }
-const std::string &Token::getLexeme() const { return lexeme; }
+Token::Token(Token::Kind kind, int64_t value):
+  kind(kind), resolved(true), value(value) {}
+
+Token::Kind Token::getKind() const { return kind; }
+std::string_view Token::getLexeme() const { return lexeme; }
 
 std::ostream &operator<<(std::ostream &out, const Token &tok) {
   out << "Token(";
@@ -32,6 +38,8 @@ std::ostream &operator<<(std::ostream &out, const Token &tok) {
     case Token::ID:         out << "ID";         break;
     case Token::LABEL:      out << "LABEL";      break;
     case Token::WORD:       out << "WORD";       break;
+    case Token::IMPORT:     out << "IMPORT";     break;
+    case Token::EXPORT:     out << "EXPORT";     break;
     case Token::COMMA:      out << "COMMA";      break;
     case Token::LPAREN:     out << "LPAREN";     break;
     case Token::RPAREN:     out << "RPAREN";     break;
@@ -41,28 +49,47 @@ std::ostream &operator<<(std::ostream &out, const Token &tok) {
     case Token::WHITESPACE: out << "WHITESPACE"; break;
     case Token::COMMENT:    out << "COMMENT";    break;
   }
-  out << ", " << tok.getLexeme() << ")";
+  out << ", ";
+  if (tok.getLexeme().empty()) {
+    out << tok.toNumber();
+  } else {
+    out << tok.getLexeme();
+  }
+  out << ")";
 
   return out;
 }
 
 int64_t Token::toNumber() const {
-  std::istringstream iss;
-  int64_t result;
+  if (resolved) {
+    return value;
+  }
+
+  std::string_view digits;
+  int base = 10;
 
   if (kind == INT) {
-    iss.str(lexeme);
+    digits = lexeme;
   } else if (kind == HEXINT) {
-    iss.str(lexeme.substr(2));
-    iss >> std::hex;
+    digits = lexeme.substr(2);
+    base = 16;
   } else if (kind == REG) {
-    iss.str(lexeme.substr(1));
+    digits = lexeme.substr(1);
   } else {
     // This should never happen if the user calls this function correctly
     return 0;
   }
 
-  iss >> result;
+  // Parse straight out of the source buffer. Out of range values saturate,
+  // as described in scanner.h.
+  int64_t result = 0;
+  std::from_chars_result r =
+      std::from_chars(digits.data(), digits.data() + digits.size(), result,
+                      base);
+  if (r.ec == std::errc::result_out_of_range) {
+    return digits[0] == '-' ? std::numeric_limits<int64_t>::min()
+                            : std::numeric_limits<int64_t>::max();
+  }
   return result;
 }
 
@@ -106,146 +133,121 @@ class AsmDFA {
     };
 
   private:
-    /* A set of all accepting states for the DFA.
-     * Currently non-accepting states are not actually present anywhere
-     * in memory, but a list can be found in the constructor.
-     */
-    std::set<State> acceptingStates;
+    typedef DFATable<State, LARGEST_STATE + 1> Table;
 
     /*
-     * The transition function for the DFA, stored as a map.
+     * The transition function, accepting states, state-to-kind mapping and
+     * run classes for the DFA. Built by the compiler from buildTable() and
+     * stored in read-only memory.
      */
+    static const Table table;
+
+    static constexpr Table buildTable() {
+      Table t(FAIL);
+
+      t.accept(ID, Token::ID);
+      t.accept(LABEL, Token::LABEL);
+      t.accept(DOTID, Token::WORD);
+      t.accept(COMMA, Token::COMMA);
+      t.accept(LPAREN, Token::LPAREN);
+      t.accept(RPAREN, Token::RPAREN);
+      t.accept(INT, Token::INT);
+      t.accept(ZERO, Token::INT);
+      t.accept(HEXINT, Token::HEXINT);
+      t.accept(REG, Token::REG);
+      t.accept(WHITESPACE, Token::WHITESPACE);
+      t.accept(COMMENT, Token::COMMENT);
+      //Non-accepting states are DOT, MINUS, ZEROX, DOLLARS, START
 
-    std::array<std::array<State, 128>, LARGEST_STATE + 1> transitionFunction;
+      t.registerTransition(START, scansimd::RUN_ALPHA, ID);
+      t.registerTransition(START, ".", DOT);
+      t.registerTransition(START, "0", ZERO);
+      t.registerTransition(START, "123456789", INT);
+      t.registerTransition(START, "-", MINUS);
+      t.registerTransition(START, ";", COMMENT);
+      t.registerTransition(START, scansimd::RUN_SPACE, WHITESPACE);
+      t.registerTransition(START, "$", DOLLARS);
+      t.registerTransition(START, ",", COMMA);
+      t.registerTransition(START, "(", LPAREN);
+      t.registerTransition(START, ")", RPAREN);
+      t.registerTransition(ID, scansimd::RUN_ALNUM, ID);
+      t.registerTransition(ID, ":", LABEL);
+      t.registerTransition(DOT, scansimd::RUN_ALPHA, DOTID);
+      t.registerTransition(DOTID, scansimd::RUN_ALPHA, DOTID);
+      t.registerTransition(ZERO, "x", ZEROX);
+      t.registerTransition(ZERO, scansimd::RUN_DIGIT, INT);
+      t.registerTransition(ZEROX, scansimd::RUN_XDIGIT, HEXINT);
+      t.registerTransition(HEXINT, scansimd::RUN_XDIGIT, HEXINT);
+      t.registerTransition(MINUS, scansimd::RUN_DIGIT, INT);
+      t.registerTransition(INT, scansimd::RUN_DIGIT, INT);
+      t.registerTransition(COMMENT, scansimd::RUN_LINE, COMMENT);
+      t.registerTransition(WHITESPACE, scansimd::RUN_SPACE, WHITESPACE);
+      t.registerTransition(DOLLARS, scansimd::RUN_DIGIT, REG);
+      t.registerTransition(REG, scansimd::RUN_DIGIT, REG);
+
+      return t;
+    }
 
     /*
      * Converts a state to a kind to allow construction of Tokens from States.
      * Throws an exception if conversion is not possible.
      */
     Token::Kind stateToKind(State s) const {
-      switch(s) {
-        case ID:         return Token::ID;
-        case LABEL:      return Token::LABEL;
-        case DOTID:      return Token::WORD;
-        case COMMA:      return Token::COMMA;
-        case LPAREN:     return Token::LPAREN;
-        case RPAREN:     return Token::RPAREN;
-        case INT:        return Token::INT;
-        case ZERO:       return Token::INT;
-        case HEXINT:     return Token::HEXINT;
-        case REG:        return Token::REG;
-        case WHITESPACE: return Token::WHITESPACE;
-        case COMMENT:    return Token::COMMENT;
-        default: throw ScanningFailure("ERROR: Cannot convert state to kind.");
+      if (table.kind[s] < 0) {
+        throw ScanningFailure("ERROR: Cannot convert state to kind.");
       }
+      return static_cast<Token::Kind>(table.kind[s]);
     }
 
 
   public:
     /* Tokenizes an input string according to the Simplified Maximal Munch
-     * scanning algorithm.
+     * scanning algorithm. Each lexeme is a view of the input from the start
+     * of the token to the current position, so nothing is copied.
+     *
+     * Whenever the DFA enters a state that loops on a whole character class
+     * (identifiers, numbers, whitespace, comments) the rest of that run is
+     * skipped with scansimd::skipRun, so only the characters at token
+     * boundaries go through the transition table.
+     *
+     * The template argument selects whether WHITESPACE and COMMENT tokens
+     * are produced; each mode is its own instantiation, so the choice costs
+     * nothing inside the loop.
      */
-    std::vector<Token> simplifiedMaximalMunch(const std::string &input) const {
+    template <bool keepTrivia>
+    std::vector<Token> simplifiedMaximalMunch(std::string_view input) const {
       std::vector<Token> result;
 
-      State state = start();
-      std::string munchedInput;
+      const char *posn = input.data();
+      const char *end = posn + input.size();
 
-      // We can't use a range-based for loop effectively here
-      // since the iterator doesn't always increment.
-      for (std::string::const_iterator inputPosn = input.begin();
-           inputPosn != input.end();) {
+      while (posn < end) {
+        const char *tokenStart = posn;
+        State state = start();
 
-        State oldState = state;
-        state = transition(state, *inputPosn);
-
-        if (!failed(state)) {
-          munchedInput += *inputPosn;
-          oldState = state;
-
-          ++inputPosn;
-        }
-
-        if (inputPosn == input.end() || failed(state)) {
-          if (accept(oldState)) {
-            result.push_back(Token(stateToKind(oldState), munchedInput));
-
-            munchedInput = "";
-            state = start();
-          } else {
-            if (failed(state)) {
-              munchedInput += *inputPosn;
-            }
-            throw ScanningFailure("ERROR: Simplified maximal munch failed on input: "
-                                 + munchedInput);
+        while (posn < end) {
+          State next = transition(state, *posn);
+          if (failed(next)) {
+            break;
           }
+          state = next;
+          posn = scansimd::skipRun(table.runClass[state], posn + 1, end);
         }
-      }
-
-      return result;
-    }
 
-    /* Initializes the accepting states for the DFA.
-     */
-    AsmDFA() {
-      acceptingStates = {ID, LABEL, DOTID, HEXINT,
-                           INT, ZERO, COMMA, REG,
-                           LPAREN, RPAREN, WHITESPACE, COMMENT};
-      //Non-accepting states are DOT, MINUS, ZEROX, DOLLARS, START
-
-      // Initialize transitions for the DFA
-      for (size_t i = 0; i < transitionFunction.size(); ++i) {
-        for (size_t j = 0; j < transitionFunction[0].size(); ++j) {
-          transitionFunction[i][j] = FAIL;
+        if (!accept(state)) {
+          // Include the offending character, if any, in the message.
+          const char *last = posn < end ? posn + 1 : posn;
+          throw ScanningFailure("ERROR: Simplified maximal munch failed on input: "
+              + std::string(tokenStart, last));
         }
-      }
-
-      registerTransition(START, isalpha, ID);
-      registerTransition(START, ".", DOT);
-      registerTransition(START, "0", ZERO);
-      registerTransition(START, "123456789", INT);
-      registerTransition(START, "-", MINUS);
-      registerTransition(START, ";", COMMENT);
-      registerTransition(START, isspace, WHITESPACE);
-      registerTransition(START, "$", DOLLARS);
-      registerTransition(START, ",", COMMA);
-      registerTransition(START, "(", LPAREN);
-      registerTransition(START, ")", RPAREN);
-      registerTransition(ID, isalnum, ID);
-      registerTransition(ID, ":", LABEL);
-      registerTransition(DOT, isalpha, DOTID);
-      registerTransition(DOTID, isalpha, DOTID);
-      registerTransition(ZERO, "x", ZEROX);
-      registerTransition(ZERO, isdigit, INT);
-      registerTransition(ZEROX, isxdigit, HEXINT);
-      registerTransition(HEXINT, isxdigit, HEXINT);
-      registerTransition(MINUS, isdigit, INT);
-      registerTransition(INT, isdigit, INT);
-      registerTransition(COMMENT, [](int c) -> int { return c != '\n'; },
-          COMMENT);
-      registerTransition(WHITESPACE, isspace, WHITESPACE);
-      registerTransition(DOLLARS, isdigit, REG);
-      registerTransition(REG, isdigit, REG);
-    }
-
-    // Register a transition on all chars in chars
-    void registerTransition(State oldState, const std::string &chars,
-        State newState) {
-      for (char c : chars) {
-        transitionFunction[oldState][c] = newState;
-      }
-    }
-
-    // Register a transition on all chars matching test
-    // For some reason the cctype functions all use ints, hence the function
-    // argument type.
-    void registerTransition(State oldState, int (*test)(int), State newState) {
 
-      for (int c = 0; c < 128; ++c) {
-        if (test(c)) {
-          transitionFunction[oldState][c] = newState;
+        if (keepTrivia || (state != WHITESPACE && state != COMMENT)) {
+          result.push_back(Token(stateToKind(state),
+              std::string_view(tokenStart, posn - tokenStart)));
         }
       }
+
+      return result;
     }
 
     /* Returns the state corresponding to following a transition
@@ -253,7 +255,8 @@ class AsmDFA {
      * or a special fail state if the transition does not exist.
      */
     State transition(State state, char nextChar) const {
-      return transitionFunction[state][nextChar];
+      unsigned char c = nextChar;
+      return c < 128 ? table.transitionFunction[state][c] : FAIL;
     }
 
     /* Checks whether the state returned by transition
@@ -264,39 +267,36 @@ class AsmDFA {
     /* Checks whether the state returned by transition
      * is an accepting state.
      */
-    bool accept(State state) const {
-      return acceptingStates.count(state) > 0;
-    }
+    bool accept(State state) const { return table.accepts(state); }
 
     /* Returns the starting state of the DFA
      */
     State start() const { return START; }
 };
 
-std::vector<Token> scan(const std::string &input) {
-  static AsmDFA theDFA;
-
-  std::vector<Token> tokens = theDFA.simplifiedMaximalMunch(input);
+constexpr AsmDFA::Table AsmDFA::table = AsmDFA::buildTable();
 
-  // We need to:
-  // * Throw exceptions for WORD tokens whose lexemes aren't ".word".
-  // * Remove WHITESPACE and COMMENT tokens entirely.
+std::vector<Token> scan(std::string_view input) {
+  const AsmDFA theDFA;
 
-  std::vector<Token> newTokens;
+  // WHITESPACE and COMMENT tokens are dropped while scanning.
+  std::vector<Token> tokens = theDFA.simplifiedMaximalMunch<false>(input);
 
+  // We need to throw exceptions for WORD tokens whose lexemes aren't ".word",
+  // other than the MERL directives, which get kinds of their own.
   for (auto &token : tokens) {
-    if (token.getKind() == Token::WORD) {
-      if (token.getLexeme() == ".word") {
-        newTokens.push_back(token);
-      } else {
-        throw ScanningFailure("ERROR: DOTID token unrecognized: " +
-            token.getLexeme());
-      }
-    } else if (token.getKind() != Token::WHITESPACE
-        && token.getKind() != Token::Kind::COMMENT) {
-      newTokens.push_back(token);
+    if (token.getKind() != Token::WORD || token.getLexeme() == ".word") {
+      continue;
+    }
+    if (token.getLexeme() == ".import") {
+      token = Token(Token::IMPORT, token.getLexeme());
+    } else if (token.getLexeme() == ".export") {
+      token = Token(Token::EXPORT, token.getLexeme());
+    } else {
+      throw ScanningFailure("ERROR: DOTID token unrecognized: " +
+          std::string(token.getLexeme()));
     }
   }
 
-  return newTokens;
+  return tokens;
 }
@@ -1,6 +1,7 @@
 #ifndef CS241_SCANNER_H
 #define CS241_SCANNER_H
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 #include <cstdint>
@@ -8,8 +9,8 @@
 
 /*
  * C++ Starter code for CS241 A3
- * All code requires C++14, so if you're getting compile errors make sure to
- * use -std=c++14.
+ * All code requires C++17, so if you're getting compile errors make sure to
+ * use -std=c++17.
  *
  * This file contains helpers for asm.cc and should not need to be modified by
  * you. However, its comments contain important information and you should
@@ -24,6 +25,7 @@ class Token;
  * ID: identifiers and keywords.
  * LABEL: labels (identifiers ending in a colon).
  * WORD: the special ".word" keyword.
+ * IMPORT, EXPORT: the ".import" and ".export" directives of MERL modules.
  * COMMA: a comma.
  * LPAREN: a left parenthesis.
  * RPAREN: a right parenthesis.
@@ -32,7 +34,7 @@ class Token;
  * REG: a register between $0 and $31.
  */
 
-std::vector<Token> scan(const std::string &input);
+std::vector<Token> scan(std::string_view input);
 
 /* A scanned token produced by the scanner.
  * The "kind" tells us what kind of token it is
@@ -40,6 +42,11 @@ std::vector<Token> scan(const std::string &input);
  * the programmer typed. For example, the token
  * "abc" might have kind "ID" and lexeme "abc".
  *
+ * The lexeme is a view into the scanned input, not a copy, so the input
+ * (normally a SourceBuffer) must outlive the token. Tokens made by the
+ * assembler itself, such as a label reference replaced by its address, carry
+ * a number instead and have an empty lexeme.
+ *
  * While you can create tokens with any kind and
  * lexeme, the list of kinds produced by the
  * starter code can be found in the documentation
@@ -51,6 +58,8 @@ class Token {
       ID = 0,
       LABEL,
       WORD,
+      IMPORT,
+      EXPORT,
       COMMA,
       LPAREN,
       RPAREN,
@@ -63,13 +72,16 @@ class Token {
 
   private:
     Kind kind;
-    std::string lexeme;
+    std::string_view lexeme;
+    bool resolved;
+    int64_t value;
 
   public:
-    Token(Kind kind, std::string lexeme);
+    Token(Kind kind, std::string_view lexeme);
+    Token(Kind kind, int64_t value);
 
     Kind getKind() const;
-    const std::string &getLexeme() const;
+    std::string_view getLexeme() const;
 
     /* Converts a token to the corresponding number.
      * Only works on tokens of type INT, HEXINT, or REG.
@@ -0,0 +1,23 @@
+#include "arena.h"
+
+#include <algorithm>
+
+Arena::Arena() : current(nullptr), used(0), capacity(0), allocated(0) {}
+
+void *Arena::allocateSlow(size_t bytes, size_t align) {
+  // Oversized requests get a block of their own. new[] aligns for any
+  // fundamental type, which covers everything the arena holds.
+  size_t size = std::max(BLOCK_BYTES, bytes + align);
+  allocated += used;
+  blocks.emplace_back(new char[size]);
+  current = blocks.back().get();
+  used = 0;
+  capacity = size;
+  return allocate(bytes, align);
+}
+
+void Arena::release() {
+  blocks.clear();
+  current = nullptr;
+  used = capacity = allocated = 0;
+}
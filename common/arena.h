@@ -0,0 +1,66 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * A bump allocator for objects that all die together, such as the nodes of a
+ * parse tree.
+ *
+ * Memory is carved out of large blocks in allocation order and is never
+ * freed one object at a time: release() (or the destructor) drops every block
+ * at once. Destructors are not run, so only trivially destructible types may
+ * be created with make().
+ */
+class Arena {
+ public:
+  static const size_t BLOCK_BYTES = 64 * 1024;
+
+  Arena();
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  void *allocate(size_t bytes, size_t align) {
+    size_t begin = (used + align - 1) & ~(align - 1);
+    if (begin + bytes > capacity) {
+      return allocateSlow(bytes, align);
+    }
+    used = begin + bytes;
+    return current + begin;
+  }
+
+  template <typename T, typename... Args>
+  T *make(Args &&...args) {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "arena objects are never destroyed");
+    return new (allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+  }
+
+  // An uninitialized array of n objects of a trivial type.
+  template <typename T>
+  T *makeArray(size_t n) {
+    static_assert(std::is_trivial<T>::value, "arena arrays are uninitialized");
+    return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+  }
+
+  // Frees everything allocated so far.
+  void release();
+  // Bytes handed out so far, not counting block slack.
+  size_t bytesAllocated() const { return allocated + used; }
+
+ private:
+  void *allocateSlow(size_t bytes, size_t align);
+
+  std::vector<std::unique_ptr<char[]>> blocks;
+  char *current;
+  size_t used, capacity;
+  size_t allocated;  // bytes used in the blocks before current
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef DFATABLE_H
+#define DFATABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "scanSimd.h"
+
+/*
+ * Compile-time tables for a scanner DFA over 7-bit ASCII.
+ *
+ * A DFA builds one of these in a constexpr function and stores the result in
+ * a constexpr static member, so the transition function, accepting states,
+ * state-to-kind mapping and run classes (see scanSimd.h) are all computed by
+ * the compiler and end up in read-only memory. Nothing is set up at startup.
+ *
+ * State is the DFA's state enum and NumStates its size; a state may accept
+ * and map to a token kind only if it is below 64.
+ */
+template <typename State, size_t NumStates>
+struct DFATable {
+  std::array<std::array<State, 128>, NumStates> transitionFunction;
+  uint64_t acceptingStates;
+  std::array<int8_t, NumStates> kind;  // -1 for states that are not kinds
+  std::array<scansimd::RunClass, NumStates> runClass;
+
+  constexpr explicit DFATable(State fail)
+      : transitionFunction(), acceptingStates(0), kind(), runClass() {
+    for (size_t i = 0; i < NumStates; ++i) {
+      for (size_t j = 0; j < 128; ++j) {
+        transitionFunction[i][j] = fail;
+      }
+      kind[i] = -1;
+      runClass[i] = scansimd::RUN_NONE;
+    }
+  }
+
+  // Marks the state as accepting, producing tokens of the given kind.
+  constexpr void accept(State state, int kindOfState) {
+    acceptingStates |= uint64_t(1) << state;
+    kind[state] = static_cast<int8_t>(kindOfState);
+  }
+
+  // Register a transition on all chars in chars
+  constexpr void registerTransition(State oldState, const char *chars,
+                                    State newState) {
+    for (; *chars; ++chars) {
+      transitionFunction[oldState][static_cast<unsigned char>(*chars)] =
+          newState;
+    }
+  }
+
+  // Register a transition on all chars in a character class. If the
+  // transition is a self loop, the scanner may skip the whole run at once.
+  constexpr void registerTransition(State oldState, scansimd::RunClass chars,
+                                    State newState) {
+    for (int c = 0; c < 128; ++c) {
+      if (scansimd::inClass(chars, c)) {
+        transitionFunction[oldState][c] = newState;
+      }
+    }
+    if (oldState == newState) {
+      runClass[oldState] = chars;
+    }
+  }
+
+  bool accepts(State state) const { return (acceptingStates >> state) & 1; }
+};
+
+#endif
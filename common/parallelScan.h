@@ -0,0 +1,91 @@
+#ifndef PARALLELSCAN_H
+#define PARALLELSCAN_H
+
+#include <cstddef>
+#include <future>
+#include <string_view>
+#include <vector>
+
+#include "threadPool.h"
+
+/*
+ * Chunked scanning for large inputs.
+ *
+ * In both the MIPS and the WLP4 languages every token ends at or before a
+ * newline: comments run to the end of the line, and a newline can only
+ * otherwise appear inside whitespace, which is dropped. So any position just
+ * after a '\n' starts a fresh simplified maximal munch, and scanning the
+ * pieces separately and concatenating the results gives exactly the serial
+ * token stream.
+ */
+
+// Inputs smaller than this are not worth splitting.
+const size_t MIN_SCAN_CHUNK_BYTES = 64 * 1024;
+
+// Splits input into at most numChunks pieces, each (except possibly the
+// last) ending just after a newline.
+inline std::vector<std::string_view> splitAtNewlines(std::string_view input,
+                                                     size_t numChunks) {
+  std::vector<std::string_view> chunks;
+  size_t target = input.size() / (numChunks ? numChunks : 1) + 1;
+  if (target < MIN_SCAN_CHUNK_BYTES) {
+    target = MIN_SCAN_CHUNK_BYTES;
+  }
+
+  size_t begin = 0;
+  while (begin < input.size()) {
+    size_t end = begin + target;
+    if (end >= input.size()) {
+      end = input.size();
+    } else {
+      size_t newline = input.find('\n', end);
+      end = newline == std::string_view::npos ? input.size() : newline + 1;
+    }
+    chunks.push_back(input.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+/* Scans input with scanChunk(std::string_view) -> std::vector<T> on the
+ * pool's threads and concatenates the results in source order. If any chunk
+ * throws, the exception from the earliest such chunk is rethrown. That is
+ * the error the serial scanner would have reported only if it too reports
+ * errors as it reaches them: checks that a serial scan makes after the whole
+ * input is munched belong to the caller, over the concatenated result.
+ */
+template <typename T, typename ScanFn>
+std::vector<T> parallelScan(std::string_view input, ThreadPool &pool,
+                            ScanFn scanChunk) {
+  std::vector<std::string_view> chunks =
+      splitAtNewlines(input, pool.size() * 4);
+  if (chunks.size() <= 1) {
+    return scanChunk(input);
+  }
+
+  std::vector<std::future<std::vector<T>>> pieces;
+  for (std::string_view chunk : chunks) {
+    pieces.push_back(pool.submit([chunk, &scanChunk]() {
+      return scanChunk(chunk);
+    }));
+  }
+
+  std::vector<std::vector<T>> results;
+  size_t total = 0;
+  for (auto &piece : pieces) {
+    piece.wait();
+  }
+  for (auto &piece : pieces) {
+    results.push_back(piece.get());  // rethrows in source order
+    total += results.back().size();
+  }
+
+  std::vector<T> tokens;
+  tokens.reserve(total);
+  for (auto &result : results) {
+    tokens.insert(tokens.end(), result.begin(), result.end());
+  }
+  return tokens;
+}
+
+#endif
@@ -0,0 +1,25 @@
+#include "parseTree.h"
+
+#include <algorithm>
+
+ParseTree::ParseTree() : root(nullptr) { lexemes.intern(""); }
+
+TreeNode *ParseTree::makeNode(uint32_t kind, int32_t rule,
+                              size_t numChildren) {
+  TreeNode **children =
+      numChildren == 0 ? nullptr : arena.makeArray<TreeNode *>(numChildren);
+  return arena.make<TreeNode>(TreeNode{kind, EMPTY_LEXEME, rule,
+                                       uint32_t(numChildren), children});
+}
+
+TreeNode *ParseTree::makeNode(uint32_t kind, int32_t rule,
+                              TreeNode *const *children, size_t numChildren) {
+  TreeNode *node = makeNode(kind, rule, numChildren);
+  std::copy(children, children + numChildren, node->firstChild);
+  return node;
+}
+
+void ParseTree::release() {
+  arena.release();
+  root = nullptr;
+}
@@ -0,0 +1,115 @@
+#ifndef PARSETREE_H
+#define PARSETREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "arena.h"
+#include "stringInterner.h"
+
+struct TreeNode;
+
+// The children of a node, a contiguous array of node pointers in the arena
+// of the tree the node belongs to.
+class ChildRange {
+ public:
+  ChildRange() : first(nullptr), count(0) {}
+  ChildRange(TreeNode **first, uint32_t count) : first(first), count(count) {}
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  TreeNode *&operator[](size_t i) const { return first[i]; }
+  TreeNode **begin() const { return first; }
+  TreeNode **end() const { return first + count; }
+
+ private:
+  TreeNode **first;
+  uint32_t count;
+};
+
+/*
+ * A parse tree node. It holds no strings of its own: kind and lexeme are ids
+ * in the tables of the ParseTree that allocated it, which also turns them
+ * back into names (kindName, lexeme). A node has either a lexeme or
+ * children; interior nodes have the empty lexeme, and record the number of
+ * the production rule they were reduced by (the Rule enum of wlp4Rules.h
+ * for WLP4), or -1 if it is not known. Leaves have rule -1.
+ */
+struct TreeNode {
+  uint32_t kind;
+  uint32_t lexeme;
+  int32_t rule;
+  uint32_t numChildren;
+  TreeNode **firstChild;
+
+  ChildRange children() const { return ChildRange(firstChild, numChildren); }
+};
+
+/*
+ * A parse tree together with everything its nodes refer to: the arena they
+ * are allocated from and the interned kind names and lexemes. Both
+ * wlp4parse and wlp4gen build their trees here, so a node is 24 bytes
+ * however long its strings are, and each distinct name or lexeme is stored
+ * once per tree. The whole tree is freed at once, by release() or the
+ * destructor, rather than node by node.
+ *
+ * Kind ids are handed out by internKind in order of first use. wlp4parse
+ * interns the grammar's symbols before anything else, so there a node's kind
+ * is also its grammar symbol.
+ */
+class ParseTree {
+ public:
+  static const uint32_t EMPTY_LEXEME = 0;
+
+  ParseTree();
+  ParseTree(const ParseTree &) = delete;
+  ParseTree &operator=(const ParseTree &) = delete;
+
+  uint32_t internKind(std::string_view name) { return kinds.intern(name); }
+  // The id of a kind name, or StringInterner::NOT_FOUND.
+  uint32_t findKind(std::string_view name) const { return kinds.find(name); }
+  size_t numKinds() const { return kinds.size(); }
+  const std::string &kindName(uint32_t kind) const { return kinds.str(kind); }
+  const std::string &kindName(const TreeNode *node) const {
+    return kinds.str(node->kind);
+  }
+
+  uint32_t internLexeme(std::string_view lexeme) {
+    return lexemes.intern(lexeme);
+  }
+  size_t numLexemes() const { return lexemes.size(); }
+  const std::string &lexeme(uint32_t lexeme) const {
+    return lexemes.str(lexeme);
+  }
+  const std::string &lexeme(const TreeNode *node) const {
+    return lexemes.str(node->lexeme);
+  }
+
+  TreeNode *makeLeaf(uint32_t kind, uint32_t lexeme) {
+    return arena.make<TreeNode>(TreeNode{kind, lexeme, -1, 0, nullptr});
+  }
+  TreeNode *makeLeaf(uint32_t kind, std::string_view lexeme) {
+    return makeLeaf(kind, internLexeme(lexeme));
+  }
+  // A node with numChildren child slots, left for the caller to fill in.
+  TreeNode *makeNode(uint32_t kind, int32_t rule, size_t numChildren);
+  // A node whose children are copied from children[0..numChildren).
+  TreeNode *makeNode(uint32_t kind, int32_t rule, TreeNode *const *children,
+                     size_t numChildren);
+
+  // Frees every node. The kind and lexeme tables are kept.
+  void release();
+  // Memory taken by the nodes and their child arrays.
+  size_t nodeBytes() const { return arena.bytesAllocated(); }
+
+  TreeNode *root;
+
+ private:
+  Arena arena;
+  StringInterner kinds;
+  StringInterner lexemes;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef SCANSIMD_H
+#define SCANSIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * Vectorized helpers for the scanner DFAs.
+ *
+ * Most of the bytes a scanner sees belong to long runs that a DFA state just
+ * loops on: whitespace, comments, identifiers and numbers. Each helper below
+ * finds the end of one such run, 32 bytes at a time with AVX2 or 16 with
+ * SSE2, so the DFA only has to look at the characters around token
+ * boundaries. A scalar loop handles the tail of the input and builds without
+ * either instruction set.
+ *
+ * Every function returns the first position in [p, end) that is NOT part of
+ * the run, or end.
+ */
+
+namespace scansimd {
+
+enum RunClass : uint8_t {
+  RUN_NONE = 0,  // the state has no self loop worth skipping
+  RUN_SPACE,     // isspace: ' ', '\t', '\n', '\v', '\f', '\r'
+  RUN_ALPHA,     // isalpha
+  RUN_ALNUM,     // isalnum
+  RUN_DIGIT,     // isdigit
+  RUN_XDIGIT,    // isxdigit
+  RUN_LINE       // anything up to (not including) '\n'
+};
+
+constexpr bool inClass(RunClass runClass, unsigned char c) {
+  unsigned char lower = c | 0x20;
+  switch (runClass) {
+    case RUN_SPACE:  return c == ' ' || (c >= '\t' && c <= '\r');
+    case RUN_ALPHA:  return lower >= 'a' && lower <= 'z';
+    case RUN_ALNUM:  return (lower >= 'a' && lower <= 'z') ||
+                            (c >= '0' && c <= '9');
+    case RUN_DIGIT:  return c >= '0' && c <= '9';
+    case RUN_XDIGIT: return (c >= '0' && c <= '9') ||
+                            (lower >= 'a' && lower <= 'f');
+    case RUN_LINE:   return c != '\n';
+    default:         return false;
+  }
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+#if defined(__AVX2__)
+typedef __m256i Vec;
+const size_t VEC_BYTES = 32;
+inline Vec load(const char *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+inline Vec splat(char c) { return _mm256_set1_epi8(c); }
+inline Vec eq(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+inline Vec gt(Vec a, Vec b) { return _mm256_cmpgt_epi8(a, b); }
+inline Vec add(Vec a, Vec b) { return _mm256_add_epi8(a, b); }
+inline Vec bitOr(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+inline uint32_t mask(Vec v) { return _mm256_movemask_epi8(v); }
+const uint32_t FULL_MASK = 0xffffffffu;
+#else
+typedef __m128i Vec;
+const size_t VEC_BYTES = 16;
+inline Vec load(const char *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+inline Vec splat(char c) { return _mm_set1_epi8(c); }
+inline Vec eq(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+inline Vec gt(Vec a, Vec b) { return _mm_cmpgt_epi8(a, b); }
+inline Vec add(Vec a, Vec b) { return _mm_add_epi8(a, b); }
+inline Vec bitOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+inline uint32_t mask(Vec v) { return _mm_movemask_epi8(v); }
+const uint32_t FULL_MASK = 0xffffu;
+#endif
+
+// Lanes where lo <= c <= hi. Shifting the range down to start at -128 turns
+// the unsigned range check into one signed comparison.
+inline Vec inRange(Vec c, char lo, char hi) {
+  Vec shifted = add(c, splat(static_cast<char>(-128 - lo)));
+  return gt(splat(static_cast<char>(-128 + (hi - lo) + 1)), shifted);
+}
+
+inline Vec classLanes(RunClass runClass, Vec c) {
+  Vec lower = bitOr(c, splat(0x20));
+  switch (runClass) {
+    case RUN_SPACE:  return bitOr(eq(c, splat(' ')), inRange(c, '\t', '\r'));
+    case RUN_ALPHA:  return inRange(lower, 'a', 'z');
+    case RUN_ALNUM:  return bitOr(inRange(lower, 'a', 'z'),
+                                  inRange(c, '0', '9'));
+    case RUN_DIGIT:  return inRange(c, '0', '9');
+    case RUN_XDIGIT: return bitOr(inRange(c, '0', '9'),
+                                  inRange(lower, 'a', 'f'));
+    default:         return eq(eq(c, splat('\n')), splat(0));  // RUN_LINE
+  }
+}
+
+#endif
+
+inline const char *skipRun(RunClass runClass, const char *p,
+                           const char *end) {
+  if (runClass == RUN_NONE) {
+    return p;
+  }
+#if defined(__AVX2__) || defined(__SSE2__)
+  while (static_cast<size_t>(end - p) >= VEC_BYTES) {
+    uint32_t outside = ~mask(classLanes(runClass, load(p))) & FULL_MASK;
+    if (outside) {
+      return p + __builtin_ctz(outside);
+    }
+    p += VEC_BYTES;
+  }
+#endif
+  while (p < end && inClass(runClass, *p)) {
+    p++;
+  }
+  return p;
+}
+
+}  // namespace scansimd
+
+#endif
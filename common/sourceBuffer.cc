@@ -0,0 +1,56 @@
+#include "sourceBuffer.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <utility>
+
+SourceBuffer::SourceBuffer(int fd)
+    : begin(nullptr), length(0), mapped(false), pageOffset(0) {
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    // Map from the current offset so a partially consumed stdin still works.
+    // mmap takes a page-aligned offset, so the mapping starts at the page
+    // holding it and the view skips the rest of that page.
+    off_t pos = lseek(fd, 0, SEEK_CUR);
+    if (pos >= 0 && pos < st.st_size) {
+      off_t pageSize = sysconf(_SC_PAGESIZE);
+      off_t base = pos - pos % pageSize;
+      void *addr = mmap(nullptr, st.st_size - base, PROT_READ, MAP_PRIVATE, fd,
+                        base);
+      if (addr != MAP_FAILED) {
+        pageOffset = pos - base;
+        begin = static_cast<const char *>(addr) + pageOffset;
+        length = st.st_size - pos;
+        mapped = true;
+        return;
+      }
+    }
+  }
+
+  char chunk[1 << 16];
+  while (true) {
+    ssize_t n = read(fd, chunk, sizeof(chunk));
+    if (n > 0) {
+      owned.append(chunk, n);
+    } else if (n == 0 || errno != EINTR) {
+      break;
+    }
+  }
+  begin = owned.data();
+  length = owned.size();
+}
+
+SourceBuffer::SourceBuffer(std::string contents)
+    : owned(std::move(contents)), mapped(false), pageOffset(0) {
+  begin = owned.data();
+  length = owned.size();
+}
+
+SourceBuffer::~SourceBuffer() {
+  if (mapped) {
+    munmap(const_cast<char *>(begin - pageOffset), pageOffset + length);
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef SOURCEBUFFER_H
+#define SOURCEBUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*
+ * An immutable, pinned copy of a tool's whole input.
+ *
+ * Scanners hand out lexemes as std::string_view into this buffer instead of
+ * copying them into their own strings, so the buffer must outlive every token
+ * (and every tree node) that refers to it. It can be neither copied nor moved
+ * for the same reason.
+ *
+ * Regular files are mapped with mmap; pipes and terminals are read into a heap
+ * allocation.
+ */
+class SourceBuffer {
+ public:
+  // Reads everything from the file descriptor, e.g. STDIN_FILENO.
+  explicit SourceBuffer(int fd);
+  // Takes ownership of input that is already in memory.
+  explicit SourceBuffer(std::string contents);
+  ~SourceBuffer();
+
+  SourceBuffer(const SourceBuffer &) = delete;
+  SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+  const char *data() const { return begin; }
+  size_t size() const { return length; }
+  std::string_view view() const { return std::string_view(begin, length); }
+
+ private:
+  std::string owned;  // used unless the input was mapped
+  const char *begin;
+  size_t length;
+  bool mapped;
+  size_t pageOffset;  // of begin in the first page mapped
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * A bounded queue between exactly one producer thread and one consumer
+ * thread, for handing work down a pipeline of stages. It is a ring of slots
+ * indexed by two counters that only ever grow: the producer alone advances
+ * tail and the consumer alone advances head, so neither takes a lock. The
+ * release store of a counter publishes the slot it covers, and everything
+ * the producer wrote before pushing a value, to the consumer that pops it.
+ *
+ * A full or empty queue is waited out by spinning briefly and then
+ * yielding, since a stage waiting on its neighbour has nothing else to do.
+ * The producer calls close() after its last push; pop() then drains what is
+ * left and returns false.
+ */
+template <typename T>
+class SpscQueue {
+ public:
+  // Holds at least capacity values; the ring is rounded up to a power of 2.
+  explicit SpscQueue(size_t capacity) : head(0), tail(0), closed(false) {
+    size_t size = 1;
+    while (size < capacity) {
+      size *= 2;
+    }
+    slots.resize(size);
+    mask = size - 1;
+  }
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  // Producer only. Waits while the queue is full.
+  void push(T value) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    for (unsigned spins = 0;
+         t - head.load(std::memory_order_acquire) == slots.size(); spins++) {
+      pause(spins);
+    }
+    slots[t & mask] = std::move(value);
+    tail.store(t + 1, std::memory_order_release);
+  }
+
+  // Producer only. No value is pushed after this.
+  void close() { closed.store(true, std::memory_order_release); }
+
+  // Consumer only. Waits for a value and moves it into value, or returns
+  // false once the queue is closed and empty.
+  bool pop(T &value) {
+    size_t h = head.load(std::memory_order_relaxed);
+    for (unsigned spins = 0; h == tail.load(std::memory_order_acquire);
+         spins++) {
+      // tail is read again after closed, in case the last push and close()
+      // both happened since the test above.
+      if (closed.load(std::memory_order_acquire) &&
+          h == tail.load(std::memory_order_acquire)) {
+        return false;
+      }
+      pause(spins);
+    }
+    value = std::move(slots[h & mask]);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  static void pause(unsigned spins) {
+    if (spins >= 64) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::vector<T> slots;
+  size_t mask;
+  // Each counter on its own cache line, so the two threads do not keep
+  // taking the line from each other.
+  alignas(64) std::atomic<size_t> head;
+  alignas(64) std::atomic<size_t> tail;
+  alignas(64) std::atomic<bool> closed;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#include "stringInterner.h"
+
+uint32_t StringInterner::intern(std::string_view s) {
+  auto it = ids.find(s);
+  if (it != ids.end()) {
+    return it->second;
+  }
+  uint32_t id = count;
+  size_t segment = segmentOf(id);
+  if (!segments[segment]) {
+    segments[segment].reset(new std::string[FIRST_SEGMENT << segment]);
+  }
+  std::string &stored = segments[segment][id - segmentBegin(segment)];
+  stored = s;
+  count++;
+  ids.emplace(stored, id);
+  return id;
+}
+
+uint32_t StringInterner::find(std::string_view s) const {
+  auto it = ids.find(s);
+  return it == ids.end() ? NOT_FOUND : it->second;
+}
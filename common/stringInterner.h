@@ -0,0 +1,57 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/*
+ * Maps strings to small dense ids, 0, 1, 2, ... in order of first appearance,
+ * and back. Each distinct string is stored once; the references returned by
+ * str() stay valid for the life of the interner.
+ *
+ * The strings are kept in segments that are never moved, each twice the size
+ * of the one before, so str() only reads memory that intern() has finished
+ * writing. One thread may therefore intern while others look up ids it has
+ * already handed them (through an SpscQueue, say); intern() and find()
+ * themselves are for one thread at a time.
+ */
+class StringInterner {
+ public:
+  StringInterner() : count(0) {}
+  StringInterner(const StringInterner &) = delete;
+  StringInterner &operator=(const StringInterner &) = delete;
+
+  uint32_t intern(std::string_view s);
+  // The id of s, or NOT_FOUND if it has not been interned.
+  uint32_t find(std::string_view s) const;
+  const std::string &str(uint32_t id) const {
+    size_t segment = segmentOf(id);
+    return segments[segment][id - segmentBegin(segment)];
+  }
+  size_t size() const { return count; }
+
+  static const uint32_t NOT_FOUND = UINT32_MAX;
+
+ private:
+  // Segment k holds ids [FIRST_SEGMENT * (2^k - 1), FIRST_SEGMENT * (2^(k+1)
+  // - 1)); enough segments for every uint32_t id.
+  static const size_t FIRST_SEGMENT = 64;
+  static const size_t NUM_SEGMENTS = 27;
+
+  static size_t segmentOf(uint32_t id) {
+    return 63 - __builtin_clzll(uint64_t(id) / FIRST_SEGMENT + 1);
+  }
+  static size_t segmentBegin(size_t segment) {
+    return FIRST_SEGMENT * ((size_t(1) << segment) - 1);
+  }
+
+  std::unique_ptr<std::string[]> segments[NUM_SEGMENTS];
+  size_t count;
+  std::unordered_map<std::string_view, uint32_t> ids;  // views into segments
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * A fixed set of worker threads that run submitted tasks in FIFO order.
+ * submit() returns a future for the task's result; an exception thrown by a
+ * task is stored in its future and rethrown by get(). The destructor finishes
+ * every queued task before joining the workers.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t numThreads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  size_t size() const { return workers.size(); }
+
+  template <typename F>
+  std::future<decltype(std::declval<F &>()())> submit(F f) {
+    typedef decltype(f()) Result;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(f));
+    std::future<Result> result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push_back([task]() { (*task)(); });
+    }
+    wakeup.notify_one();
+    return result;
+  }
+
+ private:
+  void workerLoop();
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  bool stopping;
+};
+
+#endif
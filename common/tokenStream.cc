@@ -0,0 +1,151 @@
+#include "tokenStream.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char MAGIC[8] = {'W', 'L', 'P', '4', 'T', 'O', 'K', '\0'};
+const size_t HEADER_BYTES = sizeof(MAGIC) + 5 * sizeof(uint32_t);
+
+void appendWord(std::string &out, uint32_t w) {
+  out.append(reinterpret_cast<const char *>(&w), sizeof(w));
+}
+
+}  // namespace
+
+TokenStreamWriter::TokenStreamWriter(
+    std::string_view source, const std::vector<std::string_view> &names)
+    : source(source), lastOffset(0), line(1), lineStart(0) {
+  for (std::string_view name : names) {
+    kindNames.push_back(intern(name));
+  }
+}
+
+uint32_t TokenStreamWriter::intern(std::string_view s) {
+  auto it = stringIndex.find(s);
+  if (it != stringIndex.end()) {
+    return it->second;
+  }
+  uint32_t index = strings.size();
+  strings.push_back(s);
+  stringIndex.emplace(s, index);
+  return index;
+}
+
+void TokenStreamWriter::add(uint32_t kind, std::string_view lexeme) {
+  // Tokens arrive in source order, so only the text since the previous
+  // token needs to be searched for newlines.
+  size_t offset = lexeme.data() - source.data();
+  for (size_t i = lastOffset; i < offset; i++) {
+    if (source[i] == '\n') {
+      line++;
+      lineStart = i + 1;
+    }
+  }
+  lastOffset = offset;
+
+  TokenRecord record;
+  record.kind = kind;
+  record.lexeme = intern(lexeme);
+  record.line = line;
+  record.column = offset - lineStart + 1;
+  records.push_back(record);
+}
+
+std::string TokenStreamWriter::finish() const {
+  std::string blob;
+  std::vector<uint32_t> stringEnds;
+  for (std::string_view s : strings) {
+    blob += s;
+    stringEnds.push_back(blob.size());
+  }
+  uint32_t stringBytes = blob.size();
+  blob.resize((blob.size() + 3) & ~size_t(3), '\0');
+
+  std::string out(MAGIC, sizeof(MAGIC));
+  appendWord(out, TOKEN_STREAM_VERSION);
+  appendWord(out, kindNames.size());
+  appendWord(out, strings.size());
+  appendWord(out, records.size());
+  appendWord(out, stringBytes);
+  for (uint32_t name : kindNames) {
+    appendWord(out, name);
+  }
+  for (uint32_t end : stringEnds) {
+    appendWord(out, end);
+  }
+  out += blob;
+  out.append(reinterpret_cast<const char *>(records.data()),
+             records.size() * sizeof(TokenRecord));
+  return out;
+}
+
+bool TokenStreamReader::isTokenStream(std::string_view data) {
+  return data.size() >= sizeof(MAGIC) &&
+         memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+TokenStreamReader::TokenStreamReader(std::string_view data) : data(data) {
+  if (!isTokenStream(data) || data.size() < HEADER_BYTES) {
+    throw std::runtime_error("not a binary token stream");
+  }
+  if (word(8) != TOKEN_STREAM_VERSION) {
+    throw std::runtime_error("unsupported token stream version");
+  }
+  numKinds = word(12);
+  numStrings = word(16);
+  numTokens = word(20);
+  stringBytes = word(24);
+
+  kindNamesOffset = HEADER_BYTES;
+  stringEndsOffset = kindNamesOffset + size_t(numKinds) * 4;
+  blobOffset = stringEndsOffset + size_t(numStrings) * 4;
+  recordsOffset = blobOffset + ((size_t(stringBytes) + 3) & ~size_t(3));
+  if (recordsOffset + size_t(numTokens) * sizeof(TokenRecord) != data.size()) {
+    throw std::runtime_error("truncated or oversized token stream");
+  }
+
+  // Validate every index once so the accessors can trust them.
+  uint32_t previousEnd = 0;
+  for (uint32_t i = 0; i < numStrings; i++) {
+    uint32_t end = word(stringEndsOffset + i * 4);
+    if (end < previousEnd || end > stringBytes) {
+      throw std::runtime_error("corrupt token stream string table");
+    }
+    previousEnd = end;
+  }
+  for (uint32_t i = 0; i < numKinds; i++) {
+    if (word(kindNamesOffset + i * 4) >= numStrings) {
+      throw std::runtime_error("corrupt token stream kind table");
+    }
+  }
+  for (uint32_t i = 0; i < numTokens; i++) {
+    TokenRecord r = record(i);
+    if (r.kind >= numKinds || r.lexeme >= numStrings) {
+      throw std::runtime_error("corrupt token stream record");
+    }
+  }
+}
+
+uint32_t TokenStreamReader::word(size_t offset) const {
+  uint32_t w;
+  memcpy(&w, data.data() + offset, sizeof(w));
+  return w;
+}
+
+TokenRecord TokenStreamReader::record(size_t i) const {
+  TokenRecord r;
+  memcpy(&r, data.data() + recordsOffset + i * sizeof(TokenRecord), sizeof(r));
+  return r;
+}
+
+std::string_view TokenStreamReader::string(uint32_t index) const {
+  uint32_t begin = index == 0 ? 0 : word(stringEndsOffset + (index - 1) * 4);
+  uint32_t end = word(stringEndsOffset + index * 4);
+  return data.substr(blobOffset + begin, end - begin);
+}
+
+std::string_view TokenStreamReader::kindName(uint32_t kind) const {
+  return string(word(kindNamesOffset + kind * 4));
+}
@@ -0,0 +1,93 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Compact binary token stream, an alternative to the "KIND lexeme" text that
+ * wlp4scan writes and wlp4parse reads.
+ *
+ * Layout (all integers are 32-bit, in the byte order of the machine that
+ * wrote the stream):
+ *
+ *   char magic[8]              "WLP4TOK" followed by a NUL
+ *   u32  version               TOKEN_STREAM_VERSION
+ *   u32  numKinds
+ *   u32  numStrings
+ *   u32  numTokens
+ *   u32  stringBytes
+ *   u32  kindName[numKinds]    string index of each kind's name
+ *   u32  stringEnd[numStrings] end offset of each string in the blob
+ *   char blob[stringBytes]     padded with NULs to a multiple of 4
+ *   TokenRecord records[numTokens]
+ *
+ * Lexemes are deduplicated, so every "int" or ";" in a program shares one
+ * string. Readers detect the format from the magic number, so tools can keep
+ * accepting the text format as well.
+ */
+
+const uint32_t TOKEN_STREAM_VERSION = 1;
+
+struct TokenRecord {
+  uint32_t kind;    // index into the kind name table
+  uint32_t lexeme;  // index into the string table
+  uint32_t line;    // 1-based position of the lexeme in the source
+  uint32_t column;
+};
+
+class TokenStreamWriter {
+ public:
+  // source is the scanned text; lexemes passed to add() must point into it
+  // so their positions can be recorded. Kind ids index kindNames.
+  TokenStreamWriter(std::string_view source,
+                    const std::vector<std::string_view> &kindNames);
+
+  void add(uint32_t kind, std::string_view lexeme);
+
+  // Returns the encoded stream.
+  std::string finish() const;
+
+ private:
+  uint32_t intern(std::string_view s);
+
+  std::string_view source;
+  std::vector<uint32_t> kindNames;
+  std::vector<std::string_view> strings;
+  std::unordered_map<std::string_view, uint32_t> stringIndex;
+  std::vector<TokenRecord> records;
+
+  // Position of the last token, so lines are counted incrementally.
+  size_t lastOffset;
+  uint32_t line;
+  size_t lineStart;
+};
+
+/* Zero-copy reader over an encoded stream. Every string_view it returns
+ * points into data, which must outlive the reader. Throws std::runtime_error
+ * if the stream is malformed.
+ */
+class TokenStreamReader {
+ public:
+  static bool isTokenStream(std::string_view data);
+
+  explicit TokenStreamReader(std::string_view data);
+
+  size_t size() const { return numTokens; }
+  uint32_t kindCount() const { return numKinds; }
+  TokenRecord record(size_t i) const;
+  std::string_view kindName(uint32_t kind) const;
+  std::string_view string(uint32_t index) const;
+
+ private:
+  uint32_t word(size_t offset) const;
+
+  std::string_view data;
+  uint32_t numKinds, numStrings, numTokens, stringBytes;
+  size_t kindNamesOffset, stringEndsOffset, blobOffset, recordsOffset;
+};
+
+#endif
@@ -0,0 +1,220 @@
+#include "treeStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const char MAGIC[8] = {'W', 'L', 'P', '4', 'T', 'R', 'E', '\0'};
+const size_t HEADER_BYTES = sizeof(MAGIC) + 6 * sizeof(uint32_t);
+
+void appendWord(std::string &out, uint32_t w) {
+  out.append(reinterpret_cast<const char *>(&w), sizeof(w));
+}
+
+}  // namespace
+
+std::string writeTreeStream(const ParseTree &tree, const TreeNode *root,
+                            uint32_t grammarChecksum) {
+  if (!root) {
+    return "";
+  }
+
+  // Trees are as deep as their longest statement list, so the preorder walk
+  // uses an explicit stack.
+  std::vector<TreeRecord> records;
+  std::vector<const TreeNode *> stack{root};
+  while (!stack.empty()) {
+    const TreeNode *node = stack.back();
+    stack.pop_back();
+    records.push_back(
+        TreeRecord{node->kind, node->rule, node->numChildren, node->lexeme});
+    for (size_t i = node->numChildren; i-- > 0;) {
+      stack.push_back(node->children()[i]);
+    }
+  }
+
+  std::string blob;
+  std::vector<uint32_t> stringEnds;
+  for (size_t i = 0; i < tree.numLexemes(); i++) {
+    blob += tree.lexeme(uint32_t(i));
+    stringEnds.push_back(blob.size());
+  }
+  // Kind names follow the lexemes in the string table.
+  std::vector<uint32_t> kindNames;
+  for (size_t i = 0; i < tree.numKinds(); i++) {
+    kindNames.push_back(stringEnds.size());
+    blob += tree.kindName(uint32_t(i));
+    stringEnds.push_back(blob.size());
+  }
+  uint32_t stringBytes = blob.size();
+  blob.resize((blob.size() + 3) & ~size_t(3), '\0');
+
+  std::string out(MAGIC, sizeof(MAGIC));
+  appendWord(out, TREE_STREAM_VERSION);
+  appendWord(out, grammarChecksum);
+  appendWord(out, kindNames.size());
+  appendWord(out, stringEnds.size());
+  appendWord(out, records.size());
+  appendWord(out, stringBytes);
+  for (uint32_t name : kindNames) {
+    appendWord(out, name);
+  }
+  for (uint32_t end : stringEnds) {
+    appendWord(out, end);
+  }
+  out += blob;
+  out.append(reinterpret_cast<const char *>(records.data()),
+             records.size() * sizeof(TreeRecord));
+  return out;
+}
+
+bool TreeStreamReader::isTreeStream(std::string_view data) {
+  return data.size() >= sizeof(MAGIC) &&
+         memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+TreeStreamReader::TreeStreamReader(std::string_view data) : data(data) {
+  if (!isTreeStream(data) || data.size() < HEADER_BYTES) {
+    throw std::runtime_error("not a binary parse tree");
+  }
+  if (word(8) != TREE_STREAM_VERSION) {
+    throw std::runtime_error("unsupported parse tree version");
+  }
+  checksum = word(12);
+  numKinds = word(16);
+  numStrings = word(20);
+  numNodes = word(24);
+  stringBytes = word(28);
+
+  kindNamesOffset = HEADER_BYTES;
+  stringEndsOffset = kindNamesOffset + size_t(numKinds) * 4;
+  blobOffset = stringEndsOffset + size_t(numStrings) * 4;
+  recordsOffset = blobOffset + ((size_t(stringBytes) + 3) & ~size_t(3));
+  if (recordsOffset + size_t(numNodes) * sizeof(TreeRecord) != data.size()) {
+    throw std::runtime_error("truncated or oversized parse tree");
+  }
+
+  uint32_t previousEnd = 0;
+  for (uint32_t i = 0; i < numStrings; i++) {
+    uint32_t end = word(stringEndsOffset + i * 4);
+    if (end < previousEnd || end > stringBytes) {
+      throw std::runtime_error("corrupt parse tree string table");
+    }
+    previousEnd = end;
+  }
+  for (uint32_t i = 0; i < numKinds; i++) {
+    if (word(kindNamesOffset + i * 4) >= numStrings) {
+      throw std::runtime_error("corrupt parse tree kind table");
+    }
+  }
+}
+
+uint32_t TreeStreamReader::word(size_t offset) const {
+  uint32_t w;
+  memcpy(&w, data.data() + offset, sizeof(w));
+  return w;
+}
+
+std::string_view TreeStreamReader::string(uint32_t index) const {
+  uint32_t begin = index == 0 ? 0 : word(stringEndsOffset + (index - 1) * 4);
+  uint32_t end = word(stringEndsOffset + index * 4);
+  return data.substr(blobOffset + begin, end - begin);
+}
+
+TreeNode *TreeStreamReader::read(ParseTree &tree,
+                                 const TreeGrammar &grammar) const {
+  if (numNodes == 0) {
+    return nullptr;
+  }
+
+  // The stream's ids may differ from those tree hands out, so the grammar's
+  // symbols are interned there too and compared as tree kinds.
+  std::vector<uint32_t> kinds(numKinds), lexemes(numStrings);
+  for (uint32_t i = 0; i < numKinds; i++) {
+    kinds[i] = tree.internKind(string(word(kindNamesOffset + i * 4)));
+  }
+  for (uint32_t i = 0; i < numStrings; i++) {
+    lexemes[i] = tree.internLexeme(string(i));
+  }
+  std::vector<std::vector<uint32_t>> rules;
+  for (const auto &rule : grammar.rules) {
+    rules.emplace_back();
+    for (std::string_view symbol : rule) {
+      rules.back().push_back(tree.internKind(symbol));
+    }
+  }
+  std::vector<bool> terminal;
+  for (std::string_view symbol : grammar.terminals) {
+    uint32_t kind = tree.internKind(symbol);
+    terminal.resize(std::max(terminal.size(), size_t(kind) + 1));
+    terminal[kind] = true;
+  }
+
+  // Nodes whose children are still being read, with how many have been.
+  std::vector<std::pair<TreeNode *, uint32_t>> open;
+  TreeNode *root = nullptr;
+  for (uint32_t i = 0; i < numNodes; i++) {
+    TreeRecord r;
+    memcpy(&r, data.data() + recordsOffset + i * sizeof(TreeRecord),
+           sizeof(r));
+    if (r.kind >= numKinds || r.lexeme >= numStrings) {
+      throw std::runtime_error("corrupt parse tree record");
+    }
+    if (i > 0 && open.empty()) {
+      throw std::runtime_error("parse tree has more than one root");
+    }
+    // A leaf has no rule; a node of a rule with no right-hand side has no
+    // children either, but does have its rule.
+    if (r.rule < -1 || (r.rule >= 0 && size_t(r.rule) >= rules.size())) {
+      throw std::runtime_error("parse tree record has an unknown rule");
+    }
+    uint32_t kind = kinds[r.kind];
+    if (r.rule == -1 ? kind >= terminal.size() || !terminal[kind]
+                     : kind != rules[r.rule][0]) {
+      throw std::runtime_error("parse tree record has the wrong kind");
+    }
+    if (r.numChildren != (r.rule == -1 ? 0 : rules[r.rule].size() - 1)) {
+      throw std::runtime_error(
+          "parse tree record has the wrong number of children");
+    }
+    if (!open.empty()) {
+      const TreeNode *parent = open.back().first;
+      if (kind != rules[parent->rule][open.back().second + 1]) {
+        throw std::runtime_error(
+            "parse tree record does not match its parent's rule");
+      }
+    }
+    // Each child is at least one more record.
+    if (r.numChildren > numNodes - i - 1) {
+      throw std::runtime_error("parse tree ends inside a node");
+    }
+
+    TreeNode *node;
+    if (r.numChildren == 0) {
+      node = tree.makeLeaf(kind, lexemes[r.lexeme]);
+      node->rule = r.rule;
+    } else {
+      node = tree.makeNode(kind, r.rule, r.numChildren);
+    }
+    if (open.empty()) {
+      root = node;
+    } else {
+      open.back().first->children()[open.back().second++] = node;
+    }
+    if (r.numChildren > 0) {
+      open.emplace_back(node, 0);
+    }
+    while (!open.empty() &&
+           open.back().second == open.back().first->numChildren) {
+      open.pop_back();
+    }
+  }
+  if (!open.empty()) {
+    throw std::runtime_error("parse tree ends inside a node");
+  }
+  return root;
+}
@@ -0,0 +1,87 @@
+#ifndef TREESTREAM_H
+#define TREESTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parseTree.h"
+
+/*
+ * Compact binary parse tree, an alternative to the preorder text that
+ * wlp4parse writes and wlp4gen reads.
+ *
+ * Layout (all integers are 32-bit, in the byte order of the machine that
+ * wrote the stream):
+ *
+ *   char magic[8]              "WLP4TRE" followed by a NUL
+ *   u32  version               TREE_STREAM_VERSION
+ *   u32  grammarChecksum       identifies the grammar the rules number
+ *   u32  numKinds
+ *   u32  numStrings
+ *   u32  numNodes
+ *   u32  stringBytes
+ *   u32  kindName[numKinds]    string index of each kind's name
+ *   u32  stringEnd[numStrings] end offset of each string in the blob
+ *   char blob[stringBytes]     padded with NULs to a multiple of 4
+ *   TreeRecord records[numNodes], in preorder
+ *
+ * Kind and lexeme ids are those of the ParseTree that was written, so
+ * writing is a dump of its tables and a walk over its nodes. Readers detect
+ * the format from the magic number, so tools can keep accepting the text
+ * format as well.
+ */
+
+const uint32_t TREE_STREAM_VERSION = 1;
+
+struct TreeRecord {
+  uint32_t kind;         // index into the kind name table
+  int32_t rule;          // as in TreeNode
+  uint32_t numChildren;  // the next records are the children's subtrees
+  uint32_t lexeme;       // index into the string table
+};
+
+// Encodes the tree below root (nothing at all if root is null).
+// grammarChecksum is written for readers to check that the rule numbers
+// mean what they expect.
+std::string writeTreeStream(const ParseTree &tree, const TreeNode *root,
+                            uint32_t grammarChecksum);
+
+// The grammar a stream's records are checked against: each rule as its
+// left-hand side followed by its right-hand side, numbered as in
+// TreeRecord::rule, and the kinds of the terminals.
+struct TreeGrammar {
+  std::vector<std::vector<std::string_view>> rules;
+  std::vector<std::string_view> terminals;
+};
+
+/* Reader over an encoded stream. The constructor checks the header and
+ * tables, read() the records; both throw std::runtime_error if the stream is
+ * malformed.
+ */
+class TreeStreamReader {
+ public:
+  static bool isTreeStream(std::string_view data);
+
+  explicit TreeStreamReader(std::string_view data);
+
+  uint32_t grammarChecksum() const { return checksum; }
+  size_t size() const { return numNodes; }
+  // Builds the encoded tree in tree, interning its kinds and lexemes there,
+  // and returns its root. Every interior node must be of a rule of grammar,
+  // with that rule's left-hand side as its kind and its right-hand side as
+  // its children's; every leaf must be a terminal, with NO_RULE (-1).
+  TreeNode *read(ParseTree &tree, const TreeGrammar &grammar) const;
+
+ private:
+  uint32_t word(size_t offset) const;
+  std::string_view string(uint32_t index) const;
+
+  std::string_view data;
+  uint32_t checksum, numKinds, numStrings, numNodes, stringBytes;
+  size_t kindNamesOffset, stringEndsOffset, blobOffset, recordsOffset;
+};
+
+#endif
@@ -0,0 +1,120 @@
+// Generated by wlp4parse --emit-rules from WLP4.lr1. Do not edit.
+#ifndef WLP4RULES_H
+#define WLP4RULES_H
+
+#include <cstdint>
+
+// Grammar::imageChecksum() of the grammar these rules come from.
+constexpr uint32_t RULES_GRAMMAR_CHECKSUM = 0xd3f9bde5;
+
+// The production rules of WLP4.lr1, numbered as in the file. A
+// parse tree node reduced by a rule records it in TreeNode::rule.
+enum Rule : int32_t {
+  NO_RULE = -1,  // leaves, and nodes that match no rule
+  R_start = 0,  // start BOF procedures EOF
+  R_procedures_procedure_procedures = 1,
+  R_procedures_main = 2,
+  R_procedure = 3,  // procedure INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
+  R_main = 4,  // main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
+  R_params_EMPTY = 5,
+  R_params_paramlist = 6,
+  R_paramlist_dcl = 7,
+  R_paramlist_dcl_COMMA_paramlist = 8,
+  R_type_INT = 9,
+  R_type_INT_STAR = 10,
+  R_dcls_EMPTY = 11,
+  R_dcls_dcls_dcl_BECOMES_NUM_SEMI = 12,
+  R_dcls_dcls_dcl_BECOMES_NULL_SEMI = 13,
+  R_dcl = 14,  // dcl type ID
+  R_statements_EMPTY = 15,
+  R_statements_statements_statement = 16,
+  R_statement_lvalue_BECOMES_expr_SEMI = 17,
+  R_statement_IF_LPAREN_test_RPAREN_LBRACE_statements_RBRACE_ELSE_LBRACE_statements_RBRACE = 18,
+  R_statement_WHILE_LPAREN_test_RPAREN_LBRACE_statements_RBRACE = 19,
+  R_statement_PRINTLN_LPAREN_expr_RPAREN_SEMI = 20,
+  R_statement_DELETE_LBRACK_RBRACK_expr_SEMI = 21,
+  R_test_expr_EQ_expr = 22,
+  R_test_expr_NE_expr = 23,
+  R_test_expr_LT_expr = 24,
+  R_test_expr_LE_expr = 25,
+  R_test_expr_GE_expr = 26,
+  R_test_expr_GT_expr = 27,
+  R_expr_term = 28,
+  R_expr_expr_PLUS_term = 29,
+  R_expr_expr_MINUS_term = 30,
+  R_term_factor = 31,
+  R_term_term_STAR_factor = 32,
+  R_term_term_SLASH_factor = 33,
+  R_term_term_PCT_factor = 34,
+  R_factor_ID = 35,
+  R_factor_NUM = 36,
+  R_factor_NULL = 37,
+  R_factor_LPAREN_expr_RPAREN = 38,
+  R_factor_AMP_lvalue = 39,
+  R_factor_STAR_factor = 40,
+  R_factor_NEW_INT_LBRACK_expr_RBRACK = 41,
+  R_factor_ID_LPAREN_RPAREN = 42,
+  R_factor_ID_LPAREN_arglist_RPAREN = 43,
+  R_arglist_expr = 44,
+  R_arglist_expr_COMMA_arglist = 45,
+  R_lvalue_ID = 46,
+  R_lvalue_STAR_factor = 47,
+  R_lvalue_LPAREN_lvalue_RPAREN = 48,
+  NUM_RULES = 49
+};
+
+// Each rule as "lhs rhs...", the form of an interior node's line
+// in the preorder tree format.
+constexpr const char *RULE_TEXT[NUM_RULES] = {
+    "start BOF procedures EOF",
+    "procedures procedure procedures",
+    "procedures main",
+    "procedure INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE",
+    "main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE",
+    "params",
+    "params paramlist",
+    "paramlist dcl",
+    "paramlist dcl COMMA paramlist",
+    "type INT",
+    "type INT STAR",
+    "dcls",
+    "dcls dcls dcl BECOMES NUM SEMI",
+    "dcls dcls dcl BECOMES NULL SEMI",
+    "dcl type ID",
+    "statements",
+    "statements statements statement",
+    "statement lvalue BECOMES expr SEMI",
+    "statement IF LPAREN test RPAREN LBRACE statements RBRACE ELSE LBRACE statements RBRACE",
+    "statement WHILE LPAREN test RPAREN LBRACE statements RBRACE",
+    "statement PRINTLN LPAREN expr RPAREN SEMI",
+    "statement DELETE LBRACK RBRACK expr SEMI",
+    "test expr EQ expr",
+    "test expr NE expr",
+    "test expr LT expr",
+    "test expr LE expr",
+    "test expr GE expr",
+    "test expr GT expr",
+    "expr term",
+    "expr expr PLUS term",
+    "expr expr MINUS term",
+    "term factor",
+    "term term STAR factor",
+    "term term SLASH factor",
+    "term term PCT factor",
+    "factor ID",
+    "factor NUM",
+    "factor NULL",
+    "factor LPAREN expr RPAREN",
+    "factor AMP lvalue",
+    "factor STAR factor",
+    "factor NEW INT LBRACK expr RBRACK",
+    "factor ID LPAREN RPAREN",
+    "factor ID LPAREN arglist RPAREN",
+    "arglist expr",
+    "arglist expr COMMA arglist",
+    "lvalue ID",
+    "lvalue STAR factor",
+    "lvalue LPAREN lvalue RPAREN",
+};
+
+#endif
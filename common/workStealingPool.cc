@@ -0,0 +1,90 @@
+#include "workStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(size_t numThreads)
+    : nextDeque(0), queued(0), unfinished(0), sleeping(0), stopping(false) {
+  if (numThreads == 0) {
+    numThreads = 1;
+  }
+  for (size_t i = 0; i < numThreads; i++) {
+    deques.emplace_back(new Deque());
+  }
+  for (size_t i = 0; i < numThreads; i++) {
+    workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeup.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+  unfinished++;
+  Deque &deque = *deques[nextDeque++ % deques.size()];
+  {
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    deque.tasks.push_back(std::move(task));
+    queued++;
+  }
+  // A worker counts itself sleeping before it checks queued, and this checks
+  // sleeping after counting the task, so either it sees the task or this
+  // sees it. Locking the mutex waits for it to be on wakeup.
+  if (sleeping > 0) {
+    { std::lock_guard<std::mutex> lock(mutex); }
+    wakeup.notify_one();
+  }
+}
+
+void WorkStealingPool::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this]() { return unfinished == 0; });
+}
+
+bool WorkStealingPool::take(size_t self, std::function<void()> &task) {
+  for (size_t i = 0; i < deques.size(); i++) {
+    Deque &deque = *deques[(self + i) % deques.size()];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task = std::move(deque.tasks.front());
+      deque.tasks.pop_front();
+    } else {
+      task = std::move(deque.tasks.back());
+      deque.tasks.pop_back();
+    }
+    queued--;
+    return true;
+  }
+  return false;
+}
+
+void WorkStealingPool::workerLoop(size_t self) {
+  while (true) {
+    std::function<void()> task;
+    if (take(self, task)) {
+      task();
+      if (--unfinished == 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.notify_all();
+      }
+      continue;
+    }
+
+    // Every deque was empty when looked at: sleep until a task is queued.
+    std::unique_lock<std::mutex> lock(mutex);
+    sleeping++;
+    wakeup.wait(lock, [this]() { return stopping || queued > 0; });
+    sleeping--;
+    if (queued == 0) {
+      return;  // stopping and nothing left to run
+    }
+  }
+}
@@ -0,0 +1,69 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * A fixed set of worker threads for many independent tasks of uneven size,
+ * such as whole compilations. Unlike ThreadPool, which hands out one shared
+ * queue's tasks in order, every worker has a deque of its own: submit()
+ * deals the tasks out among them in turn, a worker runs its own from the
+ * front, and one whose deque is empty steals from the back of another's.
+ * submit() and a worker's take lock only the deque concerned, so workers
+ * only contend when they steal, and they take the pool's mutex only to
+ * sleep once every deque is empty. A worker stuck on one large task does not
+ * hold up the rest of its deque.
+ *
+ * Tasks must not throw. wait() returns once every task submitted so far has
+ * finished; the destructor finishes any still queued before joining the
+ * workers.
+ */
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(size_t numThreads);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  size_t size() const { return workers.size(); }
+
+  void submit(std::function<void()> task);
+  void wait();
+
+ private:
+  struct Deque {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void workerLoop(size_t self);
+  // Takes a task from worker self's own deque, or failing that steals one.
+  // Returns false if every deque was empty.
+  bool take(size_t self, std::function<void()> &task);
+
+  std::vector<std::unique_ptr<Deque>> deques;
+  std::vector<std::thread> workers;
+  std::atomic<size_t> nextDeque;  // the one submit() deals to next
+
+  // queued changes under the lock of the deque a task joins or leaves, with
+  // it. Workers sleep on wakeup and wait() on finished; mutex makes checking
+  // the counts and sleeping atomic, and guards stopping.
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::condition_variable finished;
+  std::atomic<size_t> queued;      // tasks in the deques
+  std::atomic<size_t> unfinished;  // tasks submitted and not yet finished
+  std::atomic<size_t> sleeping;    // workers waiting on wakeup
+  bool stopping;
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef LINK_H
+#define LINK_H
+
+#include <list>
+
+#include "merl.h"
+
+// Links all the MERL objects in the given list, by recursively
+// calling the "linking constructor" that links two MERL objects.
+// The list is consumed in the process.
+MERL link(std::list<MERL>& merls);
+
+#endif
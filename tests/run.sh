@@ -0,0 +1,128 @@
+#!/bin/bash
+# Regression tests for inputs the tools must reject cleanly.
+# Usage: tests/run.sh [directory with the built tools, default build]
+
+BIN=${1:-build}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+failures=0
+
+# expectError name expected-message command...: the command must exit 1
+# with stderr "ERROR: expected-message".
+expectError() {
+  local name=$1 message=$2
+  shift 2
+  "$@" > /dev/null 2> "$TMP/stderr"
+  local status=$?
+  if [ $status -ne 1 ] || [ "$(cat "$TMP/stderr")" != "ERROR: $message" ]; then
+    echo "FAIL $name: exit $status, stderr: $(cat "$TMP/stderr")"
+    failures=$((failures + 1))
+  else
+    echo "ok   $name"
+  fi
+}
+
+# A binary parse tree (little-endian) with one record, given as the bytes of
+# its kind, rule, numChildren and lexeme: the kind and lexeme are both
+# "start".
+treeStream() {
+  printf 'WLP4TRE\0'
+  printf '\x01\0\0\0\xe5\xbd\xf9\xd3'   # version, grammar checksum
+  printf '\x01\0\0\0\x01\0\0\0\x01\0\0\0\x05\0\0\0'  # counts, string bytes
+  printf '\0\0\0\0\x05\0\0\0start\0\0\0'  # kind names, string ends, blob
+  printf "$1$2$3$4"
+}
+
+Z='\0\0\0\0'
+treeStream $Z $Z $Z $Z > "$TMP/childless.btree"
+expectError "interior node without its children" \
+  "parse tree record has the wrong number of children" \
+  "$BIN/wlp4gen" < "$TMP/childless.btree"
+
+treeStream $Z '\x31\0\0\0' $Z $Z > "$TMP/rule.btree"
+expectError "rule out of range" "parse tree record has an unknown rule" \
+  "$BIN/wlp4gen" < "$TMP/rule.btree"
+
+treeStream $Z $Z '\x03\0\0\0' $Z > "$TMP/truncated.btree"
+expectError "children past the end" "parse tree ends inside a node" \
+  "$BIN/wlp4gen" < "$TMP/truncated.btree"
+
+treeStream $Z '\xff\xff\xff\xff' $Z $Z > "$TMP/nonTerminalLeaf.btree"
+expectError "leaf of a non-terminal" "parse tree record has the wrong kind" \
+  "$BIN/wlp4gen" < "$TMP/nonTerminalLeaf.btree"
+
+# start -> EOF EOF EOF, where the rule has BOF procedures EOF.
+{
+  printf 'WLP4TRE\0'
+  printf '\x01\0\0\0\xe5\xbd\xf9\xd3'
+  printf '\x02\0\0\0\x02\0\0\0\x04\0\0\0\x08\0\0\0'
+  printf '\0\0\0\0\x01\0\0\0\x05\0\0\0\x08\0\0\0startEOF'
+  printf '\0\0\0\0\0\0\0\0\x03\0\0\0\0\0\0\0'
+  for i in 1 2 3; do
+    printf '\x01\0\0\0\xff\xff\xff\xff\0\0\0\0\x01\0\0\0'
+  done
+} > "$TMP/wrongChild.btree"
+expectError "child not of its parent's rule" \
+  "parse tree record does not match its parent's rule" \
+  "$BIN/wlp4gen" < "$TMP/wrongChild.btree"
+
+printf 'start BOF EOF\nBOF BOF\nEOF EOF\n' > "$TMP/noRule.tree"
+expectError "text tree of no rule" "malformed parse tree at start" \
+  "$BIN/wlp4gen" < "$TMP/noRule.tree"
+
+# A grammar whose first action reduces by a rule past the last one.
+awk '!done && NF == 4 && ($3 == "shift" || $3 == "reduce") {
+       $3 = "reduce"; $4 = 100000; done = 1
+     } 1' "$(dirname "$0")/../wlp4parse/WLP4.lr1" > "$TMP/badAction.lr1"
+expectError "grammar action out of range" \
+  "malformed grammar file: bad action 0" \
+  "$BIN/wlp4parse" --grammar "$TMP/badAction.lr1" --compile-grammar
+
+# A NUM out of range near the start of a program big enough to be scanned in
+# chunks, and a character no token starts with near the end: the whole input
+# is munched before NUMs are checked, however many threads scan it.
+{
+  echo "int wain(int a, int b) { return 99999999999; }"
+  for i in $(seq 60000); do echo "// filler line $i"; done
+  echo '$'
+} > "$TMP/twoErrors.wlp4"
+for threads in 1 8; do
+  expectError "munch error after a bad NUM, $threads threads" \
+    'Simplified maximal munch failed on input: $' \
+    "$BIN/wlp4scan" --threads $threads < "$TMP/twoErrors.wlp4"
+done
+for pipeline in "" --pipeline; do
+  expectError "munch error after a bad NUM, wlp4c $pipeline" \
+    'Simplified maximal munch failed on input: $' \
+    "$BIN/wlp4c" $pipeline < "$TMP/twoErrors.wlp4"
+done
+
+# expectOutput name pipeline: the shell pipeline must succeed and write
+# something; the checksum of what it wrote is left in $TMP/sum. Run with the
+# default 8 MB stack, which a recursive walk of these trees would overflow.
+expectOutput() {
+  local name=$1 pipeline=$2
+  (ulimit -s 8192; set -o pipefail; eval "$pipeline" | cksum) > "$TMP/sum"
+  local status=$?
+  if [ $status -ne 0 ] || [ "$(cat "$TMP/sum")" = "4294967295 0" ]; then
+    echo "FAIL $name: exit $status"
+    failures=$((failures + 1))
+  else
+    echo "ok   $name"
+  fi
+}
+
+# Long statement lists and deeply nested blocks and expressions, as
+# wlp4parse --synthetic makes them, compiled serially and on threads.
+for input in "--synthetic 300000" "--synthetic 10 --nesting 200000"; do
+  expectOutput "wlp4gen on $input" "'$BIN/wlp4parse' $input | '$BIN/wlp4gen'"
+  mv "$TMP/sum" "$TMP/serial"
+  expectOutput "wlp4gen --threads 4 on $input" \
+    "'$BIN/wlp4parse' $input | '$BIN/wlp4gen' --threads 4"
+  if ! cmp -s "$TMP/serial" "$TMP/sum"; then
+    echo "FAIL wlp4gen --threads 4 on $input: output differs from serial"
+    failures=$((failures + 1))
+  fi
+done
+
+[ $failures -eq 0 ]
@@ -0,0 +1,397 @@
+#include "compiler.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "assembler.h"
+#include "ast.h"
+#include "codeGenerator.h"
+#include "link.h"
+#include "parallelScan.h"
+#include "parseEngine.h"
+#include "parseTree.h"
+#include "spscQueue.h"
+#include "treeStream.h"
+#include "typeChecker.h"
+#include "wlp4Direct.h"
+#include "wlp4Rules.h"
+#include "wlp4scanner.h"
+
+using namespace std;
+
+bool loadGrammar(Grammar &grammar, ostream &err) {
+  grammar.loadEmbedded();
+  if (grammar.imageChecksum() != DIRECT_GRAMMAR_CHECKSUM ||
+      grammar.imageChecksum() != RULES_GRAMMAR_CHECKSUM) {
+    err << "ERROR: the parser and code generator were built from different "
+           "grammars"
+        << endl;
+    return false;
+  }
+  return true;
+}
+
+bool parseOptions(int argc, const char *const argv[], Options &options) {
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "--emit" && i + 1 < argc) {
+      string stage = argv[++i];
+      if (stage == "tokens") {
+        options.emit = TOKENS;
+      } else if (stage == "tree") {
+        options.emit = TREE;
+      } else if (stage == "asm") {
+        options.emit = ASM;
+      } else if (stage == "merl") {
+        options.emit = MERL_MODULE;
+      } else {
+        return false;
+      }
+    } else if (arg == "--binary") {
+      options.binary = true;
+    } else if (arg == "--pipeline") {
+      options.pipeline = true;
+    } else if (arg == "--batch" && i + 1 < argc) {
+      options.manifest = argv[++i];
+    } else if (arg == "--jobs" && i + 1 < argc) {
+      options.numJobs = atoi(argv[++i]);
+    } else if (arg.substr(0, 2) != "--") {
+      options.libraries.push_back(arg);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+string usage(const string &program) {
+  return "Usage: " + program +
+         " [--emit tokens|tree|asm|merl] [--binary] [--pipeline]"
+         " [--batch manifest [--jobs N]] [library.merl ...] < program.wlp4";
+}
+
+// The grammar symbol of each kind of token.
+static vector<int> tokenSymbols(const Grammar &grammar) {
+  vector<int> symbols(WLP4Token::COMMENT + 1);
+  for (int k = WLP4Token::ID; k <= WLP4Token::COMMENT; k++) {
+    symbols[k] = grammar.lookupSymbol(
+        WLP4Token::kindName(static_cast<WLP4Token::Kind>(k)));
+  }
+  return symbols;
+}
+
+// Turns the scanned tokens into the leaves BOF tokens EOF of tree, as
+// wlp4parse does with the text wlp4scan writes.
+static vector<TreeNode *> makeLeaves(const Grammar &grammar, ParseTree &tree,
+                                     const vector<WLP4Token> &tokens) {
+  vector<int> kindSymbol = tokenSymbols(grammar);
+
+  vector<TreeNode *> sequence;
+  sequence.reserve(tokens.size() + 2);
+  sequence.push_back(tree.makeLeaf(grammar.lookupSymbol("BOF"), "BOF"));
+  for (const WLP4Token &token : tokens) {
+    sequence.push_back(
+        tree.makeLeaf(kindSymbol[token.getKind()], token.getLexeme()));
+  }
+  sequence.push_back(tree.makeLeaf(grammar.lookupSymbol("EOF"), "EOF"));
+  return sequence;
+}
+
+/*
+ * The compiler up to the assembly, run as three stages on their own threads
+ * and joined by SpscQueues: the scanner hands on its tokens a chunk of
+ * source at a time, the LR parser shifts them as they come and hands on
+ * each procedure as soon as it is reduced, and the last stage lowers,
+ * checks and generates code for each procedure while the parser carries on
+ * with the rest. The assembly, and any error, is exactly the serial
+ * compiler's.
+ *
+ * The serial stages each finish before the next begins, so a stage's error
+ * is only reported if no earlier stage had one. Here every stage records
+ * its first error and goes on draining its input, so that its producer
+ * never waits on it, and run() reports the earliest stage's once they have
+ * all stopped. Within the last stage the same holds for wlp4gen's passes:
+ * all symbol errors come before any type error, and type errors before any
+ * code generation error, so a procedure's type error waits to see whether a
+ * later one has a symbol error.
+ */
+class Pipeline {
+ public:
+  Pipeline(const Grammar &grammar, string_view source);
+
+  // Compiles the program, leaving its assembly in assembly. Returns false
+  // after reporting an error on err.
+  bool run(string &assembly, ostream &err);
+
+ private:
+  void scanStage();
+  void parseStage();
+  void genStage();
+  void advance(bool streaming);
+
+  // How many batches of tokens, or procedures, may wait between stages.
+  static const size_t QUEUE_CAPACITY = 64;
+
+  const Grammar &grammar;
+  string_view source;
+  SpscQueue<vector<WLP4Token>> tokens;
+  SpscQueue<const TreeNode *> procedureNodes;
+
+  ParseTree tree;
+  Ast ast;
+  TypeChecker typeChecker;
+  ostringstream output;
+  CodeGenerator codeGenerator;
+
+  // Each stage's outcome. A stage writes its own before closing its output
+  // queue, so the next stage may read them once that queue is drained, and
+  // run() once the threads are joined.
+  bool scanFailed;
+  string scanError;
+  bool parsed;
+  bool parseFailed;
+  size_t parseErrorAt;
+  string symbolError;
+  string typeError;
+  string genError;
+
+  // The last stage's procedures, and how many of them have been type checked
+  // and generated.
+  vector<const Procedure *> procedures;
+  size_t checked;
+  size_t generated;
+};
+
+Pipeline::Pipeline(const Grammar &grammar, string_view source)
+    : grammar(grammar),
+      source(source),
+      tokens(QUEUE_CAPACITY),
+      procedureNodes(QUEUE_CAPACITY),
+      ast(tree),  // the tree has no root yet, so there is nothing to lower
+      typeChecker(ast),
+      codeGenerator(ast, &typeChecker, output),
+      scanFailed(false),
+      parsed(false),
+      parseFailed(false),
+      parseErrorAt(0),
+      checked(0),
+      generated(0) {
+  internGrammarKinds(grammar, tree);
+}
+
+bool Pipeline::run(string &assembly, ostream &err) {
+  thread scanner(&Pipeline::scanStage, this);
+  thread parser(&Pipeline::parseStage, this);
+  genStage();
+  scanner.join();
+  parser.join();
+
+  if (scanFailed) {
+    err << scanError << endl;
+    return false;
+  }
+  if (parseFailed) {
+    rejectParse(parseErrorAt, err);
+    return false;
+  }
+  for (const string *error : {&symbolError, &typeError, &genError}) {
+    if (!error->empty()) {
+      err << *error << endl;
+      return false;
+    }
+  }
+  assembly = output.str();
+  return true;
+}
+
+// A NUM out of range is only reported if the rest of the source munches, as
+// scanWLP4 would. Until then the chunks are still munched, but no more
+// tokens are handed on.
+void Pipeline::scanStage() {
+  try {
+    string rangeError;
+    for (string_view chunk :
+         splitAtNewlines(source, source.size() / MIN_SCAN_CHUNK_BYTES)) {
+      vector<WLP4Token> batch = munchWLP4(chunk);
+      if (rangeError.empty()) {
+        try {
+          checkNumRanges(batch);
+          tokens.push(move(batch));
+        } catch (ScanningFailure &f) {
+          rangeError = f.what();
+        }
+      }
+    }
+    if (!rangeError.empty()) {
+      scanFailed = true;
+      scanError = rangeError;
+    }
+  } catch (ScanningFailure &f) {
+    scanFailed = true;
+    scanError = f.what();
+  }
+  tokens.close();
+}
+
+void Pipeline::parseStage() {
+  vector<int> kindSymbol = tokenSymbols(grammar);
+  LRParser<Grammar> parser(grammar, grammar, tree);
+  parser.watch({R_procedure, R_main},
+               [this](TreeNode *node) { procedureNodes.push(node); });
+
+  bool ok = parser.push(tree.makeLeaf(grammar.lookupSymbol("BOF"), "BOF"));
+  vector<WLP4Token> batch;
+  while (tokens.pop(batch)) {
+    for (size_t i = 0; ok && i < batch.size(); i++) {
+      ok = parser.push(
+          tree.makeLeaf(kindSymbol[batch[i].getKind()], batch[i].getLexeme()));
+    }
+  }
+  if (ok && !scanFailed) {
+    ok = parser.push(tree.makeLeaf(grammar.lookupSymbol("EOF"), "EOF"));
+    if (ok) {
+      tree.root = parser.finish();
+      parsed = true;
+    }
+  }
+  if (!ok) {
+    parseFailed = true;
+    parseErrorAt = parser.position();
+  }
+  procedureNodes.close();
+}
+
+void Pipeline::genStage() {
+  const TreeNode *node;
+  while (procedureNodes.pop(node)) {
+    if (!symbolError.empty()) {
+      continue;
+    }
+    try {
+      procedures.push_back(ast.addProcedure(node));
+      typeChecker.declare(procedures.back());
+    } catch (TypeError &e) {
+      symbolError = e.what();
+      continue;
+    } catch (runtime_error &e) {
+      symbolError = string("ERROR: ") + e.what();
+      continue;
+    }
+    advance(true);
+  }
+
+  if (parsed && symbolError.empty()) {
+    ast.finishProcedures();
+    advance(false);
+  }
+}
+
+// Type checks, and then generates, as many of the procedures as can be, in
+// order. While streaming, a procedure that calls one not yet declared waits,
+// and so do those after it, until every procedure is.
+void Pipeline::advance(bool streaming) {
+  while (typeError.empty() && checked < procedures.size() &&
+         (!streaming || typeChecker.callsDeclared(procedures[checked]))) {
+    try {
+      typeChecker.check(procedures[checked]);
+      checked++;
+    } catch (TypeError &e) {
+      typeError = e.what();
+    }
+  }
+  while (genError.empty() && generated < checked) {
+    try {
+      codeGenerator.genProcedure(procedures[generated]);
+      generated++;
+    } catch (TypeError &e) {
+      genError = e.what();
+    }
+  }
+}
+
+bool compile(const Grammar &grammar, const list<MERL> &libraries,
+             const Options &options, string_view source, ostream &out,
+             ostream &err) {
+  string code;
+  if (options.pipeline && options.emit >= ASM) {
+    Pipeline stages(grammar, source);
+    if (!stages.run(code, err)) {
+      return false;
+    }
+  } else {
+    vector<WLP4Token> tokens;
+    try {
+      tokens = scanWLP4(source);
+    } catch (ScanningFailure &f) {
+      err << f.what() << endl;
+      return false;
+    }
+    if (options.emit == TOKENS) {
+      string output = writeTokens(source, tokens, options.binary);
+      out.write(output.data(), output.size());
+      return true;
+    }
+
+    ParseTree tree;
+    internGrammarKinds(grammar, tree);
+    vector<TreeNode *> sequence = makeLeaves(grammar, tree, tokens);
+    tree.root = parseDirect(tree, sequence, err);
+    if (!tree.root) {
+      return false;  // the parser has already reported the error
+    }
+    if (options.emit == TREE) {
+      if (options.binary) {
+        string stream =
+            writeTreeStream(tree, tree.root, grammar.imageChecksum());
+        out.write(stream.data(), stream.size());
+      } else {
+        printPreOrder(grammar, tree, tree.root, out);
+      }
+      return true;
+    }
+
+    ostringstream assembly;
+    try {
+      Ast ast(tree);
+      // Only the lexemes are needed from here on.
+      tree.release();
+      TypeChecker typeChecker(ast);
+      CodeGenerator codeGenerator(ast, &typeChecker, assembly);
+    } catch (TypeError &e) {
+      err << e.what() << endl;
+      return false;
+    } catch (runtime_error &e) {
+      err << "ERROR: " << e.what() << endl;
+      return false;
+    }
+    code = assembly.str();
+  }
+  if (options.emit == ASM) {
+    out.write(code.data(), code.size());
+    return true;
+  }
+
+  Assembler assembler(code, 1, true, err);
+  if (!assembler.assemble()) {
+    return false;
+  }
+  if (libraries.empty()) {
+    out.write(assembler.output().data(), assembler.output().size());
+    return true;
+  }
+
+  try {
+    list<MERL> merls;
+    istringstream module(assembler.output());
+    merls.emplace_back(module);
+    merls.insert(merls.end(), libraries.begin(), libraries.end());
+    out << link(merls);
+  } catch (runtime_error &e) {
+    err << "ERROR: " << e.what() << endl;
+    return false;
+  }
+  return true;
+}
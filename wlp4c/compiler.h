@@ -0,0 +1,52 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include <cstddef>
+#include <list>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "grammar.h"
+#include "merl.h"
+
+/*
+ * The compiler behind wlp4c, and behind wlp4d, which serves wlp4c's
+ * requests from a long-running process.
+ */
+
+// The stages, in order, each named for what --emit writes after it.
+enum Stage { TOKENS, TREE, ASM, MERL_MODULE };
+
+// wlp4c's command line.
+struct Options {
+  Stage emit = MERL_MODULE;
+  bool binary = false;
+  bool pipeline = false;
+  std::string manifest;  // --batch
+  size_t numJobs = std::thread::hardware_concurrency();
+  std::vector<std::string> libraries;
+};
+
+// Reads wlp4c's arguments, argv[1] onwards, into options. Returns false if
+// they are not valid; usage() says what is.
+bool parseOptions(int argc, const char *const argv[], Options &options);
+std::string usage(const std::string &program);
+
+// Loads the grammar both parsers were generated from, after checking that
+// the code generator's rule numbers come from it too. Returns false after
+// reporting on err if they do not.
+bool loadGrammar(Grammar &grammar, std::ostream &err);
+
+// Compiles the WLP4 program in source as far as options.emit, writing the
+// result to out and any error to err as the tools would have, and returns
+// whether every stage succeeded. A linked program is linked with copies of
+// libraries. Everything a compilation changes is its own, so any number can
+// run at once, sharing the grammar and the libraries.
+bool compile(const Grammar &grammar, const std::list<MERL> &libraries,
+             const Options &options, std::string_view source,
+             std::ostream &out, std::ostream &err);
+
+#endif
@@ -0,0 +1,197 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "compiler.h"
+#include "grammar.h"
+#include "merl.h"
+#include "sourceBuffer.h"
+#include "workStealingPool.h"
+
+using namespace std;
+
+// One program of a batch, and what became of it.
+struct BatchJob {
+  string input;
+  string output;
+  bool succeeded;
+  double milliseconds;
+  string errors;
+};
+
+// The file a program's output goes to when the manifest does not say: the
+// program's path with its extension replaced by the stage's.
+static string defaultOutput(const string &input, Stage emit) {
+  static const char *const extensions[] = {".tokens", ".tree", ".asm",
+                                           ".merl"};
+  size_t slash = input.rfind('/');
+  size_t dot = input.rfind('.');
+  if (dot == string::npos || (slash != string::npos && dot < slash)) {
+    dot = input.size();
+  }
+  return input.substr(0, dot) + extensions[emit];
+}
+
+// Reads the manifest: a program per line, optionally followed by the file
+// its output goes to. Blank lines and lines starting with # are skipped.
+static vector<BatchJob> readManifest(const string &path, Stage emit) {
+  ifstream manifest(path);
+  if (!manifest) {
+    throw runtime_error("cannot open " + path);
+  }
+  vector<BatchJob> jobs;
+  string line;
+  while (getline(manifest, line)) {
+    istringstream words(line);
+    BatchJob job{"", "", false, 0, ""};
+    if (!(words >> job.input) || job.input[0] == '#') {
+      continue;
+    }
+    if (!(words >> job.output)) {
+      job.output = defaultOutput(job.input, emit);
+    }
+    jobs.push_back(job);
+  }
+  return jobs;
+}
+
+// Compiles one program of a batch, catching its output and errors.
+static void runJob(const Grammar &grammar, const list<MERL> &libraries,
+                   const Options &options, BatchJob &job) {
+  auto begin = chrono::steady_clock::now();
+  ostringstream err;
+  int fd = open(job.input.c_str(), O_RDONLY);
+  if (fd < 0) {
+    err << "ERROR: cannot open " << job.input << endl;
+  } else {
+    SourceBuffer source(fd);
+    close(fd);
+    ostringstream out;
+    if (compile(grammar, libraries, options, source.view(), out, err)) {
+      ofstream file(job.output, ios::binary);
+      string output = out.str();
+      file.write(output.data(), output.size());
+      if (file.flush()) {
+        job.succeeded = true;
+      } else {
+        err << "ERROR: cannot write " << job.output << endl;
+      }
+    }
+  }
+  job.errors = err.str();
+  chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - begin;
+  job.milliseconds = elapsed.count();
+}
+
+// Compiles every program of the manifest on a WorkStealingPool of
+// options.numJobs threads, then prints a line per program with how long it
+// took, and the errors of those that failed. Returns whether they all
+// succeeded.
+static bool runBatch(const Grammar &grammar, const list<MERL> &libraries,
+                     const Options &options) {
+  vector<BatchJob> jobs = readManifest(options.manifest, options.emit);
+  size_t numJobs;
+  auto begin = chrono::steady_clock::now();
+  {
+    WorkStealingPool pool(options.numJobs);
+    numJobs = pool.size();
+    for (BatchJob &job : jobs) {
+      pool.submit([&grammar, &libraries, &options, &job]() {
+        runJob(grammar, libraries, options, job);
+      });
+    }
+    pool.wait();
+  }
+  chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - begin;
+
+  size_t failed = 0;
+  for (const BatchJob &job : jobs) {
+    cout << job.input << (job.succeeded ? " -> " + job.output : " failed")
+         << ", " << job.milliseconds << " ms\n";
+    if (!job.succeeded) {
+      failed++;
+      cerr << job.input << ":\n" << job.errors;
+    }
+  }
+  cout << jobs.size() << " programs, " << failed << " failed, "
+       << elapsed.count() << " ms on " << numJobs << " threads" << endl;
+  return failed == 0;
+}
+
+/*
+ * Usage:
+ *   wlp4c [--emit tokens|tree|asm|merl] [--binary] [--pipeline]
+ *         [library.merl ...] < program.wlp4
+ *   wlp4c --batch manifest [--jobs N] [--emit ...] [--binary] [--pipeline]
+ *         [library.merl ...]
+ *
+ * Compiles a WLP4 program in one process, handing each stage's data
+ * structures straight to the next: wlp4scan's tokens become the parser's
+ * leaves, wlp4parse's tree is lowered by wlp4gen without being written out,
+ * and the generated assembly is assembled and linked in memory. By default
+ * the result is the program as a MERL module, linked with the library
+ * modules given (e.g. print.merl alloc.merl), just like
+ *
+ *   wlp4scan | wlp4parse | wlp4gen | asm --merl > prog.merl
+ *   linker prog.merl library.merl ...
+ *
+ * --emit stops after an earlier stage and writes what that tool would have:
+ * the tokens, the parse tree (both in binary with --binary) or the
+ * assembly. Errors are reported as the tools report them, and the exit
+ * status is 1 if any stage fails.
+ *
+ * --pipeline runs the stages up to the assembly concurrently (see
+ * Pipeline in compiler.cc), so that on a large program the time taken approaches that of
+ * the slowest stage rather than the sum of them all. The output is the
+ * same. Assembling and linking still follow once the assembly is complete:
+ * the assembler's second pass needs every label, and its first already
+ * scans on several threads.
+ *
+ * --batch compiles every program listed in the manifest, a line each, on N
+ * threads (by default one per core), loading the grammar and the libraries
+ * once for them all. Each program's output goes to the file named after it
+ * on its line, or else to its own path with the extension of the last stage
+ * (.tokens, .tree, .asm or .merl). A line per program, with the time it
+ * took, is written to standard output, and the errors of any that failed to
+ * standard error.
+ */
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    cerr << usage(argv[0]) << endl;
+    return 1;
+  }
+
+  Grammar grammar;
+  if (!loadGrammar(grammar, cerr)) {
+    return 1;
+  }
+  list<MERL> libraries;
+  try {
+    for (const string &path : options.libraries) {
+      ifstream file(path);
+      if (!file) {
+        throw runtime_error("cannot open " + path);
+      }
+      libraries.emplace_back(file);
+    }
+    if (!options.manifest.empty()) {
+      return runBatch(grammar, libraries, options) ? 0 : 1;
+    }
+  } catch (runtime_error &e) {
+    cerr << "ERROR: " << e.what() << endl;
+    return 1;
+  }
+
+  SourceBuffer source(STDIN_FILENO);
+  return compile(grammar, libraries, options, source.view(), cout, cerr) ? 0
+                                                                         : 1;
+}
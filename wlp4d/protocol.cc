@@ -0,0 +1,142 @@
+#include "protocol.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+bool writeAll(int fd, const std::string &bytes) {
+  size_t done = 0;
+  while (done < bytes.size()) {
+    ssize_t n = write(fd, bytes.data() + done, bytes.size() - done);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+bool readAll(int fd, void *buffer, size_t size) {
+  char *bytes = static_cast<char *>(buffer);
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = read(fd, bytes + done, size - done);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+// A message is built up in memory and written with as few calls as it
+// takes, rather than a field at a time.
+template <typename T>
+void append(std::string &message, T value) {
+  message.append(reinterpret_cast<const char *>(&value), sizeof value);
+}
+
+void appendString(std::string &message, const std::string &s) {
+  append<uint64_t>(message, s.size());
+  message += s;
+}
+
+template <typename T>
+bool readValue(int fd, T &value) {
+  return readAll(fd, &value, sizeof value);
+}
+
+bool readString(int fd, std::string &s) {
+  uint64_t size;
+  if (!readValue(fd, size) || size > MAX_STRING_BYTES) {
+    return false;
+  }
+  s.resize(size);
+  return readAll(fd, &s[0], size);
+}
+
+}  // namespace
+
+std::string defaultSocketPath() {
+  const char *path = getenv("WLP4D_SOCKET");
+  if (path && *path) {
+    return path;
+  }
+  return "/tmp/wlp4d-" + std::to_string(getuid()) + ".sock";
+}
+
+int connectSocket(const std::string &path) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof address);
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof address.sun_path) {
+    return -1;
+  }
+  memcpy(address.sun_path, path.data(), path.size());
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof address) !=
+      0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+bool writeRequest(int fd, const Request &request) {
+  std::string message;
+  append<uint32_t>(message, PROTOCOL_VERSION);
+  append<uint32_t>(message, request.args.size());
+  for (const std::string &arg : request.args) {
+    appendString(message, arg);
+  }
+  appendString(message, request.directory);
+  appendString(message, request.input);
+  return writeAll(fd, message);
+}
+
+bool readRequest(int fd, Request &request) {
+  uint32_t version, numArgs;
+  if (!readValue(fd, version) || version != PROTOCOL_VERSION ||
+      !readValue(fd, numArgs) || numArgs > MAX_ARGS) {
+    return false;
+  }
+  request.args.resize(numArgs);
+  for (std::string &arg : request.args) {
+    if (!readString(fd, arg)) {
+      return false;
+    }
+  }
+  return readString(fd, request.directory) && readString(fd, request.input);
+}
+
+bool writeResponse(int fd, const Response &response) {
+  std::string message;
+  append<uint32_t>(message, response.status);
+  appendString(message, response.output);
+  appendString(message, response.errors);
+  return writeAll(fd, message);
+}
+
+bool readResponse(int fd, Response &response) {
+  uint32_t status;
+  if (!readValue(fd, status)) {
+    return false;
+  }
+  response.status = status;
+  return readString(fd, response.output) && readString(fd, response.errors);
+}
@@ -0,0 +1,61 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * What wlp4d and its client, wlp4dc, say to each other over a Unix domain
+ * stream socket.
+ *
+ * A request is one run of a tool (wlp4c, asm or linker): its command line,
+ * the client's working directory, which relative paths on it are relative
+ * to, and everything the tool would have read from standard input. The
+ * response is what the tool would have written to standard output and
+ * standard error, and its exit status. A client may send any number of
+ * requests on one connection, each answered before the next is read.
+ *
+ *   request:  u32 PROTOCOL_VERSION, u32 numArgs, numArgs strings (the tool
+ *             name first), the directory, the input
+ *   response: u32 status, the output, the errors
+ *
+ * where a string is its u64 length followed by its bytes. Both ends are on
+ * the same machine, so integers are in its byte order.
+ */
+
+const uint32_t PROTOCOL_VERSION = 1;
+
+// Limits on what a peer may send, so that a bad length cannot have the
+// reader allocate without bound. A message over them is treated as a broken
+// connection.
+const uint32_t MAX_ARGS = 4096;
+const uint64_t MAX_STRING_BYTES = uint64_t(1) << 30;
+
+struct Request {
+  std::vector<std::string> args;
+  std::string directory;
+  std::string input;
+};
+
+struct Response {
+  int status;
+  std::string output;
+  std::string errors;
+};
+
+// The socket wlp4d listens on: $WLP4D_SOCKET, or else /tmp/wlp4d-<uid>.sock.
+std::string defaultSocketPath();
+
+// A connection to the socket at path, or -1 if nothing is listening there.
+int connectSocket(const std::string &path);
+
+// Each of these returns false if the connection fails or is closed part way
+// through. The readers also reject a message over the limits above, and
+// readRequest a request from a client of another version.
+bool writeRequest(int fd, const Request &request);
+bool readRequest(int fd, Request &request);
+bool writeResponse(int fd, const Response &response);
+bool readResponse(int fd, Response &response);
+
+#endif
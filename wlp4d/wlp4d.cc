@@ -0,0 +1,309 @@
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "assembler.h"
+#include "compiler.h"
+#include "grammar.h"
+#include "link.h"
+#include "merl.h"
+#include "protocol.h"
+
+using namespace std;
+
+// MERL modules read from files, each kept until its file's size or
+// modification time changes, so the runtime libraries every program is
+// linked with are read once.
+class ModuleCache {
+ public:
+  // The module in the file at path. Throws std::runtime_error, as MERL does,
+  // if it cannot be read.
+  shared_ptr<const MERL> get(const string &path);
+
+ private:
+  struct Entry {
+    struct timespec modified;
+    off_t size;
+    shared_ptr<const MERL> module;
+  };
+
+  mutex lock;
+  unordered_map<string, Entry> modules;
+};
+
+shared_ptr<const MERL> ModuleCache::get(const string &path) {
+  struct stat st;
+  bool exists = stat(path.c_str(), &st) == 0;
+  if (exists) {
+    lock_guard<mutex> guard(lock);
+    auto it = modules.find(path);
+    if (it != modules.end() && it->second.size == st.st_size &&
+        it->second.modified.tv_sec == st.st_mtim.tv_sec &&
+        it->second.modified.tv_nsec == st.st_mtim.tv_nsec) {
+      return it->second.module;
+    }
+  }
+
+  ifstream file(path);
+  shared_ptr<const MERL> module = make_shared<MERL>(file);
+  if (exists) {
+    lock_guard<mutex> guard(lock);
+    modules[path] = Entry{st.st_mtim, st.st_size, module};
+  }
+  return module;
+}
+
+/*
+ * Runs the tools' requests in process. Each is run as its main would have,
+ * but with the grammar loaded once and MERL modules cached, and with the
+ * request's own input, output and error streams. Requests are served
+ * concurrently, since a compilation changes nothing but its own state.
+ */
+class Server {
+ public:
+  explicit Server(const Grammar &grammar) : grammar(grammar) {}
+
+  Response serve(const Request &request);
+
+ private:
+  int runWlp4c(const Request &request, ostream &out, ostream &err);
+  int runAsm(const Request &request, ostream &out, ostream &err);
+  int runLinker(const Request &request, ostream &out, ostream &err);
+
+  // path, relative to the request's directory if it is not absolute.
+  static string resolve(const Request &request, const string &path);
+
+  const Grammar &grammar;
+  ModuleCache modules;
+};
+
+Response Server::serve(const Request &request) {
+  ostringstream out, err;
+  int status = 1;
+  const string tool = request.args.empty() ? "" : request.args[0];
+  if (tool == "wlp4c") {
+    status = runWlp4c(request, out, err);
+  } else if (tool == "asm") {
+    status = runAsm(request, out, err);
+  } else if (tool == "linker") {
+    status = runLinker(request, out, err);
+  } else {
+    err << "ERROR: wlp4d runs wlp4c, asm and linker, not \"" << tool << "\""
+        << endl;
+  }
+  return Response{status, out.str(), err.str()};
+}
+
+string Server::resolve(const Request &request, const string &path) {
+  if (path.empty() || path[0] == '/') {
+    return path;
+  }
+  return request.directory + "/" + path;
+}
+
+int Server::runWlp4c(const Request &request, ostream &out, ostream &err) {
+  vector<const char *> argv;
+  for (const string &arg : request.args) {
+    argv.push_back(arg.c_str());
+  }
+  Options options;
+  if (!parseOptions(argv.size(), argv.data(), options)) {
+    err << usage(request.args[0]) << endl;
+    return 1;
+  }
+  if (!options.manifest.empty()) {
+    err << "ERROR: wlp4d does not run batches; run wlp4c --batch itself"
+        << endl;
+    return 1;
+  }
+
+  list<MERL> libraries;
+  try {
+    for (const string &path : options.libraries) {
+      string file = resolve(request, path);
+      if (access(file.c_str(), R_OK) != 0) {
+        throw runtime_error("cannot open " + path);
+      }
+      libraries.push_back(*modules.get(file));
+    }
+  } catch (runtime_error &e) {
+    err << "ERROR: " << e.what() << endl;
+    return 1;
+  }
+  return compile(grammar, libraries, options, request.input, out, err) ? 0
+                                                                       : 1;
+}
+
+int Server::runAsm(const Request &request, ostream &out, ostream &err) {
+  size_t numThreads = 1;
+  bool merl = false;
+  for (size_t i = 1; i < request.args.size(); i++) {
+    const string &arg = request.args[i];
+    if (arg == "--threads" && i + 1 < request.args.size()) {
+      numThreads = strtoul(request.args[++i].c_str(), nullptr, 10);
+    } else if (arg == "--merl") {
+      merl = true;
+    } else {
+      err << "Usage: " << request.args[0]
+          << " [--merl] [--threads N] < program.asm" << endl;
+      return 1;
+    }
+  }
+
+  Assembler assembler(request.input, numThreads, merl, err);
+  assembler.assemble();
+  out.write(assembler.output().data(), assembler.output().size());
+  return 0;
+}
+
+int Server::runLinker(const Request &request, ostream &out, ostream &err) {
+  if (request.args.size() == 1) {
+    err << "Usage: " << request.args[0] << " <file1.merl> <file2.merl> ..."
+        << endl;
+    return 1;
+  }
+  try {
+    list<MERL> merls;
+    for (size_t i = 1; i < request.args.size(); i++) {
+      merls.push_back(*modules.get(resolve(request, request.args[i])));
+    }
+    MERL linked = link(merls);
+    linked.print(err);
+    out << linked;
+  } catch (runtime_error &e) {
+    err << "ERROR: " << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
+
+// The socket to remove when the server is stopped by a signal.
+static const char *listeningOn = nullptr;
+
+static void stop(int) {
+  unlink(listeningOn);
+  _exit(0);
+}
+
+// Listens on a new socket at path, replacing one left behind by a server
+// that is no longer running. Returns -1 after reporting an error.
+static int listenOn(const string &path) {
+  int running = connectSocket(path);
+  if (running >= 0) {
+    close(running);
+    cerr << "ERROR: wlp4d is already running on " << path << endl;
+    return -1;
+  }
+  unlink(path.c_str());
+
+  sockaddr_un address;
+  memset(&address, 0, sizeof address);
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof address.sun_path) {
+    cerr << "ERROR: socket path too long: " << path << endl;
+    return -1;
+  }
+  memcpy(address.sun_path, path.data(), path.size());
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  // The socket is created by bind, so the umask keeps it owner-only from the
+  // start rather than from a chmod afterwards.
+  mode_t mask = umask(0177);
+  bool bound = fd >= 0 && bind(fd, reinterpret_cast<sockaddr *>(&address),
+                               sizeof address) == 0;
+  umask(mask);
+  if (!bound || listen(fd, SOMAXCONN) != 0) {
+    cerr << "ERROR: cannot listen on " << path << ": " << strerror(errno)
+         << endl;
+    return -1;
+  }
+  return fd;
+}
+
+// Answers the requests on one connection until the client closes it. A
+// request that fails with an exception, such as running out of memory on a
+// huge program, closes its connection only, not the server.
+static void serveConnection(Server &server, int fd) {
+  Request request;
+  try {
+    while (readRequest(fd, request)) {
+      if (!writeResponse(fd, server.serve(request))) {
+        break;
+      }
+    }
+  } catch (const exception &) {
+  }
+  close(fd);
+}
+
+/*
+ * Usage:
+ *   wlp4d [--socket path]
+ *
+ * A compile server: runs wlp4c, asm and linker for wlp4dc, which takes the
+ * same command lines, in one long-running process. The grammar is loaded
+ * once at startup and each MERL module named on a command line is read
+ * once for as long as its file is unchanged, so a request costs only the
+ * compilation itself rather than starting a process, loading the grammar
+ * and reading the runtime libraries.
+ *
+ * The socket is $WLP4D_SOCKET, or /tmp/wlp4d-<uid>.sock, unless given; only
+ * its owner may connect. Every connection is served on a thread of its own.
+ * SIGINT or SIGTERM removes the socket and stops the server.
+ */
+int main(int argc, char *argv[]) {
+  string socketPath = defaultSocketPath();
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "--socket" && i + 1 < argc) {
+      socketPath = argv[++i];
+    } else {
+      cerr << "Usage: " << argv[0] << " [--socket path]" << endl;
+      return 1;
+    }
+  }
+
+  Grammar grammar;
+  if (!loadGrammar(grammar, cerr)) {
+    return 1;
+  }
+  Server server(grammar);
+
+  int listener = listenOn(socketPath);
+  if (listener < 0) {
+    return 1;
+  }
+  listeningOn = socketPath.c_str();
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+  // A client that goes away shows up as a failed write, not a signal.
+  signal(SIGPIPE, SIG_IGN);
+
+  while (true) {
+    int fd = accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      cerr << "ERROR: accept failed: " << strerror(errno) << endl;
+      unlink(listeningOn);
+      return 1;
+    }
+    thread(serveConnection, ref(server), fd).detach();
+  }
+}
@@ -0,0 +1,63 @@
+#include <unistd.h>
+
+#include <climits>
+#include <iostream>
+#include <string>
+
+#include "protocol.h"
+#include "sourceBuffer.h"
+
+using namespace std;
+
+/*
+ * Usage:
+ *   wlp4dc wlp4c|asm|linker [arguments ...]
+ *
+ * Runs the tool in wlp4d: the arguments, standard input, standard output,
+ * standard error and exit status are those of running the tool itself, but
+ * without starting it. The server is found at $WLP4D_SOCKET, or
+ * /tmp/wlp4d-<uid>.sock.
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " wlp4c|asm|linker [arguments ...]"
+         << endl;
+    return 1;
+  }
+
+  Request request;
+  for (int i = 1; i < argc; i++) {
+    request.args.push_back(argv[i]);
+  }
+  char directory[PATH_MAX];
+  if (getcwd(directory, sizeof directory)) {
+    request.directory = directory;
+  }
+  // Only what the tool itself would read is sent: linker, and wlp4c --batch,
+  // read their files instead.
+  bool readsInput = request.args[0] == "asm" || request.args[0] == "wlp4c";
+  for (const string &arg : request.args) {
+    readsInput = readsInput && arg != "--batch";
+  }
+  if (readsInput) {
+    SourceBuffer input(STDIN_FILENO);
+    request.input.assign(input.data(), input.size());
+  }
+
+  string path = defaultSocketPath();
+  int fd = connectSocket(path);
+  if (fd < 0) {
+    cerr << "ERROR: cannot connect to wlp4d at " << path << endl;
+    return 1;
+  }
+  Response response;
+  if (!writeRequest(fd, request) || !readResponse(fd, response)) {
+    cerr << "ERROR: lost the connection to wlp4d" << endl;
+    return 1;
+  }
+  close(fd);
+
+  cout.write(response.output.data(), response.output.size());
+  cerr.write(response.errors.data(), response.errors.size());
+  return response.status;
+}
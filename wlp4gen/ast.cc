@@ -0,0 +1,314 @@
+#include "ast.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "wlp4Rules.h"
+
+using namespace std;
+
+const char *opToken(BinaryOp op) {
+  static const char *const tokens[] = {"PLUS", "MINUS", "STAR", "SLASH",
+                                       "PCT",  "EQ",    "NE",   "LT",
+                                       "LE",   "GE",    "GT"};
+  return tokens[int(op)];
+}
+
+const char *opLexeme(BinaryOp op) {
+  static const char *const lexemes[] = {"+",  "-",  "*", "/",  "%", "==",
+                                        "!=", "<",  "<=", ">=", ">"};
+  return lexemes[int(op)];
+}
+
+Ast::Ast(const ParseTree &tree) : tree(tree) {
+  const TreeNode *root = tree.root;
+  if (!root) {
+    return;  // no program, or one whose procedures are added as they come
+  }
+  if (root->rule != R_start) {
+    malformed(root);
+  }
+
+  const TreeNode *node = root->children()[1];
+  while (node->rule == R_procedures_procedure_procedures) {
+    addProcedure(node->children()[0]);
+    node = node->children()[1];
+  }
+  if (node->rule != R_procedures_main) {
+    malformed(node);
+  }
+  addProcedure(node->children()[0]);
+  finishProcedures();
+}
+
+const Procedure *Ast::addProcedure(const TreeNode *node) {
+  Procedure *proc = lowerProcedure(node);
+  lowerPending();
+  added.push_back(proc);
+  return proc;
+}
+
+void Ast::finishProcedures() { procedures = makeList(added); }
+
+template <typename T>
+NodeList<T> Ast::makeList(const vector<T *> &nodes) {
+  T **first = arena.makeArray<T *>(nodes.size());
+  copy(nodes.begin(), nodes.end(), first);
+  return NodeList<T>(first, nodes.size());
+}
+
+void Ast::malformed(const TreeNode *node) const {
+  throw runtime_error("malformed parse tree at " +
+                      (node ? tree.kindName(node) : string("end of input")));
+}
+
+void Ast::lowerPending() {
+  // Expressions first, so that few are waiting at a time: a statement list
+  // queues a couple per statement, and nested blocks only once those are done.
+  for (;;) {
+    if (!pendingExprs.empty()) {
+      auto [node, slot] = pendingExprs.back();
+      pendingExprs.pop_back();
+      *slot = lowerExpr(node);
+    } else if (!pendingLists.empty()) {
+      auto [node, slot] = pendingLists.back();
+      pendingLists.pop_back();
+      *slot = lowerStatements(node);
+    } else {
+      break;
+    }
+  }
+}
+
+Procedure *Ast::lowerProcedure(const TreeNode *node) {
+  Procedure *p = arena.make<Procedure>();
+  ChildRange children = node->children();
+  switch (node->rule) {
+    case R_procedure:
+      p->name = children[1]->lexeme;
+      p->isMain = false;
+      p->params = lowerParams(children[3]);
+      p->dcls = lowerDcls(children[6]);
+      pendingLists.emplace_back(children[7], &p->statements);
+      pendingExprs.emplace_back(children[9], &p->result);
+      break;
+    case R_main:
+      p->name = children[1]->lexeme;
+      p->isMain = true;
+      p->params = makeList<Dcl>(
+          {lowerDcl(children[3], nullptr), lowerDcl(children[5], nullptr)});
+      p->dcls = lowerDcls(children[8]);
+      pendingLists.emplace_back(children[9], &p->statements);
+      pendingExprs.emplace_back(children[11], &p->result);
+      break;
+    default:
+      malformed(node);
+  }
+  return p;
+}
+
+Dcl *Ast::lowerDcl(const TreeNode *node, Expr *init) {
+  if (node->rule != R_dcl) {
+    malformed(node);
+  }
+  const TreeNode *type = node->children()[0];
+  if (type->rule != R_type_INT && type->rule != R_type_INT_STAR) {
+    malformed(type);
+  }
+  return arena.make<Dcl>(
+      Dcl{node->children()[1]->lexeme,
+          type->rule == R_type_INT_STAR ? TypeTable::INT_PTR : TypeTable::INT,
+          init});
+}
+
+NodeList<Dcl> Ast::lowerParams(const TreeNode *node) {
+  vector<Dcl *> params;
+  if (node->rule == R_params_paramlist) {
+    node = node->children()[0];
+    while (node->rule == R_paramlist_dcl_COMMA_paramlist) {
+      params.push_back(lowerDcl(node->children()[0], nullptr));
+      node = node->children()[2];
+    }
+    if (node->rule != R_paramlist_dcl) {
+      malformed(node);
+    }
+    params.push_back(lowerDcl(node->children()[0], nullptr));
+  } else if (node->rule != R_params_EMPTY) {
+    malformed(node);
+  }
+  return makeList(params);
+}
+
+NodeList<Dcl> Ast::lowerDcls(const TreeNode *node) {
+  // dcls is left-recursive: the last declaration is nearest the top.
+  vector<Dcl *> dcls;
+  for (;;) {
+    Expr *init;
+    if (node->rule == R_dcls_dcls_dcl_BECOMES_NUM_SEMI) {
+      init = makeExpr(Expr::NUM, node->children()[3]->lexeme);
+    } else if (node->rule == R_dcls_dcls_dcl_BECOMES_NULL_SEMI) {
+      init = makeExpr(Expr::NULL_PTR);
+    } else {
+      break;
+    }
+    dcls.push_back(lowerDcl(node->children()[1], init));
+    node = node->children()[0];
+  }
+  if (node->rule != R_dcls_EMPTY) {
+    malformed(node);
+  }
+  reverse(dcls.begin(), dcls.end());
+  return makeList(dcls);
+}
+
+NodeList<Stmt> Ast::lowerStatements(const TreeNode *node) {
+  vector<Stmt *> statements;
+  while (node->rule == R_statements_statements_statement) {
+    statements.push_back(lowerStatement(node->children()[1]));
+    node = node->children()[0];
+  }
+  if (node->rule != R_statements_EMPTY) {
+    malformed(node);
+  }
+  reverse(statements.begin(), statements.end());
+  return makeList(statements);
+}
+
+Stmt *Ast::lowerStatement(const TreeNode *node) {
+  Stmt *s = arena.make<Stmt>();
+  ChildRange children = node->children();
+  switch (node->rule) {
+    case R_statement_lvalue_BECOMES_expr_SEMI:
+      s->kind = Stmt::ASSIGN;
+      pendingExprs.emplace_back(children[0], &s->target);
+      pendingExprs.emplace_back(children[2], &s->expr);
+      break;
+    case R_statement_IF_LPAREN_test_RPAREN_LBRACE_statements_RBRACE_ELSE_LBRACE_statements_RBRACE:
+      s->kind = Stmt::IF;
+      pendingExprs.emplace_back(children[2], &s->expr);
+      pendingLists.emplace_back(children[5], &s->body);
+      pendingLists.emplace_back(children[9], &s->elseBody);
+      break;
+    case R_statement_WHILE_LPAREN_test_RPAREN_LBRACE_statements_RBRACE:
+      s->kind = Stmt::WHILE;
+      pendingExprs.emplace_back(children[2], &s->expr);
+      pendingLists.emplace_back(children[5], &s->body);
+      break;
+    case R_statement_PRINTLN_LPAREN_expr_RPAREN_SEMI:
+      s->kind = Stmt::PRINTLN;
+      pendingExprs.emplace_back(children[2], &s->expr);
+      break;
+    case R_statement_DELETE_LBRACK_RBRACK_expr_SEMI:
+      s->kind = Stmt::DELETE;
+      pendingExprs.emplace_back(children[3], &s->expr);
+      break;
+    default:
+      malformed(node);
+  }
+  return s;
+}
+
+Expr *Ast::makeExpr(Expr::Kind kind, uint32_t lexeme) {
+  return arena.make<Expr>(
+      Expr{kind, BinaryOp::PLUS, TypeTable::NONE, lexeme, 0, nullptr, nullptr,
+           NodeList<Expr>()});
+}
+
+Expr *Ast::makeBinary(BinaryOp op, const TreeNode *node) {
+  Expr *e = makeExpr(Expr::BINARY);
+  e->op = op;
+  pendingExprs.emplace_back(node->children()[0], &e->left);
+  pendingExprs.emplace_back(node->children()[2], &e->right);
+  return e;
+}
+
+Expr *Ast::lowerExpr(const TreeNode *node) {
+  // Chains and parentheses have no node of their own.
+  for (;;) {
+    if (node->rule == R_expr_term || node->rule == R_term_factor) {
+      node = node->children()[0];
+    } else if (node->rule == R_factor_LPAREN_expr_RPAREN ||
+               node->rule == R_lvalue_LPAREN_lvalue_RPAREN) {
+      node = node->children()[1];
+    } else {
+      break;
+    }
+  }
+
+  ChildRange children = node->children();
+  Expr *e;
+  switch (node->rule) {
+    case R_factor_ID:
+    case R_lvalue_ID:
+      return makeExpr(Expr::VAR, children[0]->lexeme);
+    case R_factor_NUM:
+      return makeExpr(Expr::NUM, children[0]->lexeme);
+    case R_factor_NULL:
+      return makeExpr(Expr::NULL_PTR);
+
+    case R_factor_AMP_lvalue:
+      e = makeExpr(Expr::ADDRESS_OF);
+      pendingExprs.emplace_back(children[1], &e->left);
+      return e;
+    case R_factor_STAR_factor:
+    case R_lvalue_STAR_factor:
+      e = makeExpr(Expr::DEREF);
+      pendingExprs.emplace_back(children[1], &e->left);
+      return e;
+    case R_factor_NEW_INT_LBRACK_expr_RBRACK:
+      e = makeExpr(Expr::NEW_ARRAY);
+      pendingExprs.emplace_back(children[3], &e->left);
+      return e;
+
+    case R_factor_ID_LPAREN_RPAREN:
+      return makeExpr(Expr::CALL, children[0]->lexeme);
+    case R_factor_ID_LPAREN_arglist_RPAREN: {
+      e = makeExpr(Expr::CALL, children[0]->lexeme);
+      vector<const TreeNode *> args;
+      const TreeNode *arglist = children[2];
+      while (arglist->rule == R_arglist_expr_COMMA_arglist) {
+        args.push_back(arglist->children()[0]);
+        arglist = arglist->children()[2];
+      }
+      if (arglist->rule != R_arglist_expr) {
+        malformed(arglist);
+      }
+      args.push_back(arglist->children()[0]);
+
+      Expr **first = arena.makeArray<Expr *>(args.size());
+      for (size_t i = 0; i < args.size(); i++) {
+        pendingExprs.emplace_back(args[i], &first[i]);
+      }
+      e->args = NodeList<Expr>(first, args.size());
+      return e;
+    }
+
+    case R_expr_expr_PLUS_term:
+      return makeBinary(BinaryOp::PLUS, node);
+    case R_expr_expr_MINUS_term:
+      return makeBinary(BinaryOp::MINUS, node);
+    case R_term_term_STAR_factor:
+      return makeBinary(BinaryOp::STAR, node);
+    case R_term_term_SLASH_factor:
+      return makeBinary(BinaryOp::SLASH, node);
+    case R_term_term_PCT_factor:
+      return makeBinary(BinaryOp::PCT, node);
+    case R_test_expr_EQ_expr:
+      return makeBinary(BinaryOp::EQ, node);
+    case R_test_expr_NE_expr:
+      return makeBinary(BinaryOp::NE, node);
+    case R_test_expr_LT_expr:
+      return makeBinary(BinaryOp::LT, node);
+    case R_test_expr_LE_expr:
+      return makeBinary(BinaryOp::LE, node);
+    case R_test_expr_GE_expr:
+      return makeBinary(BinaryOp::GE, node);
+    case R_test_expr_GT_expr:
+      return makeBinary(BinaryOp::GT, node);
+
+    default:
+      malformed(node);
+  }
+}
@@ -0,0 +1,190 @@
+#ifndef AST_H
+#define AST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
+#include "parseTree.h"
+#include "typeTable.h"
+
+// A list of AST nodes, a contiguous array of node pointers in the arena of
+// the Ast the list belongs to.
+template <typename T>
+class NodeList {
+ public:
+  NodeList() : first(nullptr), count(0) {}
+  NodeList(T **first, uint32_t count) : first(first), count(count) {}
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  T *operator[](size_t i) const { return first[i]; }
+  T *const *begin() const { return first; }
+  T *const *end() const { return first + count; }
+
+ private:
+  T **first;
+  uint32_t count;
+};
+
+// Pushes list onto a work stack so that its first element is on top.
+template <typename T>
+void pushReversed(std::vector<const T *> &stack, const NodeList<T> &list) {
+  for (size_t i = list.size(); i-- > 0;) {
+    stack.push_back(list[i]);
+  }
+}
+
+enum class BinaryOp : uint8_t { PLUS, MINUS, STAR, SLASH, PCT,
+                                EQ, NE, LT, LE, GE, GT };
+
+// The operator's token, e.g. "PLUS", and its lexeme, e.g. "+".
+const char *opToken(BinaryOp op);
+const char *opLexeme(BinaryOp op);
+// Whether op is one of the comparisons a test is made of.
+inline bool isComparison(BinaryOp op) { return op >= BinaryOp::EQ; }
+
+/*
+ * An expression. Parentheses and the expr/term/factor chains of the grammar
+ * are gone: a + b * c is one BINARY node whose right operand is another.
+ * An lvalue is a VAR or a DEREF whose address, rather than value, is wanted.
+ */
+struct Expr {
+  enum Kind : uint8_t {
+    VAR,
+    NUM,
+    NULL_PTR,
+    ADDRESS_OF,
+    DEREF,
+    NEW_ARRAY,
+    CALL,
+    BINARY
+  };
+
+  Kind kind;
+  BinaryOp op;          // BINARY
+  TypeId type;          // set by the TypeChecker; tests have none
+  uint32_t lexeme;      // VAR and CALL: the name; NUM: the literal
+  uint32_t slot;        // VAR: the variable's slot in its procedure, set by
+                        // the TypeChecker
+  Expr *left;           // BINARY, and the operand of ADDRESS_OF, DEREF and
+                        // NEW_ARRAY
+  Expr *right;          // BINARY
+  NodeList<Expr> args;  // CALL
+
+  // The operands in the order they are evaluated: left then right, the one
+  // operand, or the arguments.
+  size_t numOperands() const {
+    switch (kind) {
+      case BINARY:
+        return 2;
+      case ADDRESS_OF:
+      case DEREF:
+      case NEW_ARRAY:
+        return 1;
+      case CALL:
+        return args.size();
+      default:
+        return 0;
+    }
+  }
+  Expr *operand(size_t i) const {
+    return kind == CALL ? args[i] : i == 0 ? left : right;
+  }
+};
+
+struct Stmt {
+  enum Kind : uint8_t { ASSIGN, IF, WHILE, PRINTLN, DELETE };
+
+  Kind kind;
+  Expr *target;             // ASSIGN: the lvalue assigned to
+  Expr *expr;               // the value assigned, the test of IF and WHILE,
+                            // the operand of PRINTLN and DELETE
+  NodeList<Stmt> body;      // IF: the then branch; WHILE: the loop body
+  NodeList<Stmt> elseBody;  // IF
+};
+
+struct Dcl {
+  uint32_t name;
+  TypeId type;  // TypeTable::INT or INT_PTR
+  Expr *init;  // a NUM or NULL_PTR for locals, nullptr for parameters
+};
+
+struct Procedure {
+  uint32_t name;
+  bool isMain;
+  NodeList<Dcl> params;  // wain always has two
+  NodeList<Dcl> dcls;
+  NodeList<Stmt> statements;
+  Expr *result;
+};
+
+/*
+ * The abstract syntax tree wlp4gen checks and compiles, lowered from a WLP4
+ * parse tree right after it is read. Punctuation and single-child chains are
+ * dropped and the left-recursive lists (procedures, dcls, statements,
+ * arguments) become arrays, so the later passes walk far fewer nodes and
+ * never recurse down a list.
+ *
+ * Lowering does not recurse either: nested expressions and blocks are queued
+ * with the field their node belongs in and lowered from there, so however
+ * deep the parse tree is, the call stack stays flat.
+ *
+ * Names and literals are lexeme ids in the parse tree's table, which must
+ * outlive the Ast; the parse tree's nodes need not, and can be released once
+ * the Ast is built. A tree that is not a WLP4 derivation is rejected with a
+ * std::runtime_error.
+ *
+ * An Ast can also be built a procedure at a time, while the rest of the
+ * program is still being parsed: construct it from a tree with no root yet,
+ * add each procedure node as the parser reduces it, and finish.
+ */
+class Ast {
+ public:
+  explicit Ast(const ParseTree &tree);
+  Ast(const Ast &) = delete;
+  Ast &operator=(const Ast &) = delete;
+
+  const std::string &name(uint32_t lexeme) const {
+    return tree.lexeme(lexeme);
+  }
+  // Lowers a procedure or main node and returns it. The nodes below it must
+  // not change from here on; the rest of the tree may still be growing.
+  const Procedure *addProcedure(const TreeNode *node);
+  // Sets procedures to those added so far.
+  void finishProcedures();
+
+  // Memory taken by the nodes and their lists.
+  size_t bytes() const { return arena.bytesAllocated(); }
+
+  NodeList<Procedure> procedures;  // in source order, wain last
+
+ private:
+  Procedure *lowerProcedure(const TreeNode *node);
+  Dcl *lowerDcl(const TreeNode *node, Expr *init);
+  NodeList<Dcl> lowerParams(const TreeNode *node);
+  NodeList<Dcl> lowerDcls(const TreeNode *node);
+  NodeList<Stmt> lowerStatements(const TreeNode *node);
+  Stmt *lowerStatement(const TreeNode *node);
+  Expr *lowerExpr(const TreeNode *node);
+  Expr *makeExpr(Expr::Kind kind, uint32_t lexeme = 0);
+  Expr *makeBinary(BinaryOp op, const TreeNode *node);
+  void lowerPending();
+
+  template <typename T>
+  NodeList<T> makeList(const std::vector<T *> &nodes);
+
+  [[noreturn]] void malformed(const TreeNode *node) const;
+
+  const ParseTree &tree;
+  Arena arena;
+  std::vector<Procedure *> added;
+  // Nodes waiting to be lowered, each with the field the result goes in.
+  std::vector<std::pair<const TreeNode *, Expr **>> pendingExprs;
+  std::vector<std::pair<const TreeNode *, NodeList<Stmt> *>> pendingLists;
+};
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <sstream>
 #include <stack>
@@ -12,700 +13,643 @@
 
 using namespace std;
 
-bool debug = false;
-
-CodeGenerator::CodeGenerator(TreeNode *root, TypeChecker *TC)
-    : typeChecker(TC), offset(0), labelCounter(0) {
+CodeGenerator::CodeGenerator(const Ast &ast, TypeChecker *TC, ostream &out,
+                             ThreadPool *pool)
+    : ast(ast),
+      typeChecker(TC),
+      out(out),
+      offset(0),
+      labelCounter(0),
+      symbols(nullptr) {
   genPrologue();
-  genCode(root, "");
+  if (pool) {
+    genConcurrently(*pool);
+    return;
+  }
+  for (const Procedure *proc : ast.procedures) {
+    genProcedure(proc);
+  }
 };
+
+CodeGenerator::CodeGenerator(const Ast &ast, TypeChecker *TC, ostream &out,
+                             int firstLabel)
+    : ast(ast),
+      typeChecker(TC),
+      out(out),
+      offset(0),
+      labelCounter(firstLabel),
+      symbols(nullptr) {}
+
 CodeGenerator::~CodeGenerator() {}
 
+// The label numbers proc takes: one for each IF, WHILE and DELETE.
+static int labelsIn(const Procedure *proc) {
+  int labels = 0;
+  vector<const Stmt *> stack;
+  pushReversed(stack, proc->statements);
+  while (!stack.empty()) {
+    const Stmt *s = stack.back();
+    stack.pop_back();
+    if (s->kind == Stmt::IF || s->kind == Stmt::WHILE ||
+        s->kind == Stmt::DELETE) {
+      labels++;
+    }
+    pushReversed(stack, s->elseBody);
+    pushReversed(stack, s->body);
+  }
+  return labels;
+}
+
+// A procedure's code depends on nothing generated before it but the label
+// numbers used up, which can be counted beforehand; its frame offsets are
+// its own. So each procedure is generated into a buffer of its own, by a
+// generator of its own whose labels start where the procedures before it
+// leave off, and the buffers are written out in source order: the same
+// assembly as generating the procedures in turn.
+void CodeGenerator::genConcurrently(ThreadPool &pool) {
+  vector<future<string>> code;
+  for (const Procedure *proc : ast.procedures) {
+    int firstLabel = labelCounter;
+    labelCounter += labelsIn(proc);
+    code.push_back(pool.submit([this, proc, firstLabel]() {
+      ostringstream buffer;
+      CodeGenerator generator(ast, typeChecker, buffer, firstLabel);
+      generator.genProcedure(proc);
+      return buffer.str();
+    }));
+  }
+
+  for (future<string> &procedure : code) {
+    procedure.wait();
+  }
+  for (future<string> &procedure : code) {
+    string text = procedure.get();
+    out.write(text.data(), text.size());
+  }
+}
+
 void CodeGenerator::genPrologue() {
-  cout << "; begin Prologue" << endl;
-  cout << ".import init" << endl;
-  cout << ".import new" << endl;
-  cout << ".import delete" << endl;
-  cout << ".import print" << endl;
-  cout << "lis $4 ; $4 will always hold 4" << endl;
-  cout << ".word 4" << endl;
-  cout << "lis $10 ; $10 will always hold address for print" << endl;
-  cout << ".word print" << endl;
-  cout << "lis $11 ; $11 will always hold 1" << endl;
-  cout << ".word 1" << endl;
-  cout << "sub $29 , $30 , $4 ; setup frame pointer" << endl;
-  cout << ";end Prologue and begin Body" << endl;
-  cout << endl;
+  out << "; begin Prologue" << '\n';
+  out << ".import init" << '\n';
+  out << ".import new" << '\n';
+  out << ".import delete" << '\n';
+  out << ".import print" << '\n';
+  out << "lis $4 ; $4 will always hold 4" << '\n';
+  out << ".word 4" << '\n';
+  out << "lis $10 ; $10 will always hold address for print" << '\n';
+  out << ".word print" << '\n';
+  out << "lis $11 ; $11 will always hold 1" << '\n';
+  out << ".word 1" << '\n';
+  out << "sub $29 , $30 , $4 ; setup frame pointer" << '\n';
+  out << ";end Prologue and begin Body" << '\n';
+  out << '\n';
 
   // Jump to wain
-  // cout << "; reserve space for variables" << endl;
-  // cout << "; translated WLP4 code" << endl;
-  // cout << "; end Body and begin Epilogue" << endl;
-  // cout << "; deallocate parameters and local variables of wain" << endl;
+  // out << "; reserve space for variables" << '\n';
+  // out << "; translated WLP4 code" << '\n';
+  // out << "; end Body and begin Epilogue" << '\n';
+  // out << "; deallocate parameters and local variables of wain" << '\n';
   push(31);
-  cout << "lis $5" << endl;
-  cout << ".word wain" << endl;
-  cout << "jalr $5" << endl;
+  out << "lis $5" << '\n';
+  out << ".word wain" << '\n';
+  out << "jalr $5" << '\n';
   pop(31);
 
-  cout << "jr $31" << endl;
+  out << "jr $31" << '\n';
 }
 
 // by convention we push from $3
 void CodeGenerator::push(int reg) {
-  cout << "; push $" << reg << " to stack" << endl;
-  cout << "sw $" << reg << " , -4($30)" << endl;
-  cout << "sub $30, $30, $4" << endl;
+  out << "; push $" << reg << " to stack" << '\n';
+  out << "sw $" << reg << " , -4($30)" << '\n';
+  out << "sub $30, $30, $4" << '\n';
   offset -= 4;
 }
 
 // by conention we pop to $5
 void CodeGenerator::pop(int reg) {
-  cout << "; pop to $" << reg << " from stack" << endl;
-  cout << "add $30, $30, $4" << endl;
-  cout << "lw $" << reg << " , -4($30)" << endl;
+  out << "; pop to $" << reg << " from stack" << '\n';
+  out << "add $30, $30, $4" << '\n';
+  out << "lw $" << reg << " , -4($30)" << '\n';
   offset += 4;
 }
 
-void CodeGenerator::genCode(TreeNode *root, string procedure) {
-  /* Linking */
-  if (checkRule(root, {"start", "BOF", "procedures", "EOF"}, true)) {
-    cout << "; start BOF procedures EOF" << endl;
+void CodeGenerator::genProcedure(const Procedure *proc) {
+  string procName = ast.name(proc->name);
+  symbols = &typeChecker->symbolsOf(proc);
 
-    genCode(root->children[1], procedure);
-  }
-
-  else if (checkRule(root, {"procedures", "procedure", "procedures"}, true)) {
-    cout << "; procedures procedure procedures" << endl;
-
-    genCode(root->children[0], procedure);
-    genCode(root->children[1], procedure);
-  }
-
-  else if (checkRule(root, {"procedures", "main"}, true)) {
-    cout << "; procedures main" << endl;
-
-    genCode(root->children[0], procedure);
-  }
-
-  else if (checkRule(root, {"statements", "statements", "statement"}, true)) {
-    cout << "; statements statements statement" << endl;
-
-    genCode(root->children[0], procedure);
-    genCode(root->children[1], procedure);
-  }
+  if (proc->isMain) {
+    out << "; main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls "
+            "statements RETURN expr SEMI RBRACE"
+         << '\n';
+    TypeId programType = proc->params[0]->type;
+    out << "; Program type is: " << typeChecker->types.name(programType)
+        << '\n';
+    out << "wain:" << '\n';
 
-  else if (checkRule(root, {"expr", "term"}, true)) {
-    cout << "; expr term" << endl;
+    // init
+    // If the first parameter to wain is of type int* (i.e., the generated
+    // code will be passed an array), then the size of this array must be in
+    // register $2 when init is called. Note that mips.array already puts the
+    // size of the array in register $2, so you only need to make sure that
+    // your generated code does not change $2 before it calls init.
+    // If the first parameter to wain is of type int, then register $2 must
+    // contain the value 0 (zero) when init is called.
+    push(31);
+    push(2);
 
-    genCode(root->children[0], procedure);
-  }
+    if (programType == TypeTable::INT) {
+      out << "add $2, $0, $0" << '\n';
+    }
+    out << "lis $5" << '\n';
+    out << ".word init" << '\n';
+    out << "jalr $5" << '\n';
+    pop(2);
+    pop(31);
 
-  else if (checkRule(root, {"term", "factor"}, true)) {
-    cout << "; term factor" << endl;
+    out << "; begin Prologue " << procName << '\n';
+    out << "sub $29 , $30 , $4 ; setup frame pointer" << '\n';
 
-    genCode(root->children[0], procedure);
-  }
+    offset = 0;
+    symbols->symbols[0].offset = offset;
+    // param 1
+    push(1);  // push auto decrement offset
 
-  /* Parenthesized expressions */
-  else if (checkRule(root, {"factor", "LPAREN", "expr", "RPAREN"}, true)) {
-    cout << "; factor LAREN expr RPAREN" << endl;
+    symbols->symbols[1].offset = offset;
+    // param 2
+    push(2);  // push auto decrement offset
+  } else {
+    out << "; procedure INT ID LPAREN params RPAREN LBRACE dcls "
+            "statements RETURN expr SEMI RBRACE"
+         << '\n';
+    out << "; Function : " << procName << '\n';
+    out << procName << ":" << '\n';
 
-    genCode(root->children[1], procedure);
-  }
+    out << "; begin Prologue" << '\n';
+    out << "sub $29 , $30 , $4 ; assume caller-saves old frames" << '\n';
 
-  else if (checkRule(root, {"lvalue", "LPAREN", "lvalue", "RPAREN"}, true)) {
-    cout << "; factor LAREN lvalue RPAREN" << endl;
+    // Handle arguments index (they already pushed into the stack by caller)
+    // Argument Index: 4, 8, ...
+    // Local Index: 0, -4, -8, ...
+    offset = symbols->signature.size() * 4;
+    for (size_t i = 0; i < proc->params.size(); i++) {
+      symbols->symbols[i].offset = offset;
+      offset -= 4;
+    }
 
-    genCode(root->children[1], procedure);
+    // It should be that offset = 0 here;
+    assert(offset == 0);
   }
 
-  /* Literals and identifiers | Handled at upper level*/
-  // if (checkRule(root, {"ID"}, false)) {
-  // } else if (checkRule(root, {"NUM"}, false)) {
-  // } else if (checkRule(root, {"NULL"}, false)) {
-  // }
-
-  /* declaration | Handled at upper level */
-  // else if (checkRule(root, {"dcl", "type", "ID"}, true)) {
-  // }
+  // dcls (record the local variables)
+  genDcls(proc->dcls, proc->params.size());
+  genStatements(proc->statements, procName);
+  genCode(proc->result);  // expr (return)
 
-  /* Pointers */
-  else if (checkRule(root, {"factor", "AMP", "lvalue"}, true)) {
-    // not retreiving the value stored at the variable here yet
-    // Two outcomes: lvalue STAR factor (AMP cancel with STAR)
-    // lvalue ID (gets the address of ID)
-    cout << "; factor AMP lvalue" << endl;
-
-    genCode(root->children[1], procedure);
-  }
+  out << "; Epilogue" << '\n';
+  out << "; deallocate parameters and local variables of wain" << '\n';
+  offset = 0;  // resore offset
+  out << "add $30, $29, $4" << '\n';
+  out << "jr $31" << '\n';
+  out << '\n';
+}
 
-  else if (checkRule(root, {"lvalue", "STAR", "factor"}, true)) {
-    // factor AMP lvalue -> lvalue STAR factor cancels each other out
-    cout << "; lvalue STAR factor" << endl;
+// The locals' slots follow the parameters', from firstSlot on.
+void CodeGenerator::genDcls(const NodeList<Dcl> &dcls, size_t firstSlot) {
+  for (size_t i = 0; i < dcls.size(); i++) {
+    const Dcl *dcl = dcls[i];
+    const string &symbol = ast.name(dcl->name);
+
+    if (dcl->init->kind == Expr::NUM) {
+      out << "; dcls dcls dcl BECOMES NUM SEMI" << '\n';
+
+      const string &val = ast.name(dcl->init->lexeme);
+      out << "; dcl " << symbol << " = " << val << '\n';
+      out << "lis $5" << '\n';
+      out << ".word " << val << '\n';
+    } else {
+      out << "; dcls dcls dcl BECOMES NULL SEMI" << '\n';
+
+      out << "; dcl pointer " << symbol << " = NULL" << '\n';
+      out << "lis $5" << '\n';
+      out << ".word 1" << '\n';
+    }
 
-    genCode(root->children[1], procedure);
+    // push $5 onto the stack
+    symbols->symbols[firstSlot + i].offset = offset;
+    push(5);  // push auto decrement offset
   }
+}
 
-  else if (checkRule(root, {"factor", "STAR", "factor"}, true)) {
-    cout << "; factor STAR factor" << endl;
+// Blocks can nest as deep as the program likes, so statements are generated
+// from an explicit stack rather than by recursion. IF and WHILE come back to
+// their frame after each of their blocks to emit the code that follows it:
+// step counts the visits and label is the number their labels were given.
+void CodeGenerator::genStatements(const NodeList<Stmt> &statements,
+                                  const string &procedure) {
+  struct Frame {
+    const Stmt *stmt;
+    int step;
+    int label;
+  };
+  vector<Frame> frames;
+  auto pushBlock = [&](const NodeList<Stmt> &block) {
+    for (size_t i = block.size(); i-- > 0;) {
+      frames.push_back({block[i], 0, 0});
+    }
+  };
+
+  pushBlock(statements);
+  while (!frames.empty()) {
+    Frame f = frames.back();
+    frames.pop_back();
+    const Stmt *s = f.stmt;
+
+    switch (s->kind) {
+      /* Control flow */
+      case Stmt::IF: {
+        if (f.step == 0) {
+          out << "; statement IF LPAREN test RPAREN LBRACE statements RBRACE "
+                  "ELSE LBRACE statements RBRACE"
+               << '\n';
+          f.label = labelCounter++;
+        }
+        string endifLabel = procedure + "endif" + to_string(f.label);
+        string elseLabel = procedure + "else" + to_string(f.label);
+
+        if (f.step == 0) {
+          genCode(s->expr);  // test
+          out << "bne $3, $11, " << elseLabel << '\n';
+          frames.push_back({s, 1, f.label});
+          pushBlock(s->body);
+        } else if (f.step == 1) {
+          out << "beq $0, $0, " << endifLabel << '\n';
+          out << elseLabel << ":" << '\n';
+          frames.push_back({s, 2, f.label});
+          pushBlock(s->elseBody);
+        } else {
+          // end
+          out << endifLabel << ":" << '\n';
+        }
+        break;
+      }
 
-    genCode(root->children[1], procedure);
-    cout << "lw $3, 0($3) ; $3 contains the loaded value" << endl;
-  }
+      case Stmt::WHILE: {
+        if (f.step == 0) {
+          out << "; statement WHILE LPAREN test RPAREN LBRACE statements "
+                  "RBRACE"
+               << '\n';
+          f.label = labelCounter++;
+        }
+        string loopLabel = procedure + "loop" + to_string(f.label);
+        string endWhileLabel = procedure + "endWhile" + to_string(f.label);
+
+        if (f.step == 0) {
+          out << loopLabel << ":" << '\n';
+          genCode(s->expr);
+          out << "bne $3, $11, " << endWhileLabel << '\n';  // test is false
+          frames.push_back({s, 1, f.label});
+          pushBlock(s->body);
+        } else {
+          out << "beq $0, $0, " << loopLabel << '\n';
+          out << endWhileLabel << ":" << '\n';
+        }
+        break;
+      }
 
-  /* Addition */
-  else if (checkRule(root, {"expr", "expr", "PLUS", "term"}, true)) {
-    cout << "; expr expr PLUS term" << endl;
-
-    genCode(root->children[0], procedure);  // expr
-    push(3);
-    genCode(root->children[2], procedure);  // term
-    pop(5);
-
-    string l = typeChecker->typeOf(root->children[0], procedure);
-    string r = typeChecker->typeOf(root->children[2], procedure);
-
-    // $3 term, $5 expr
-    if (l == "int*" && r == "int") {
-      cout << "; int* + int" << endl;
-      cout << "mult $3, $4" << endl;
-      cout << "mflo $3"
-           << " ; $3 <- sizeof(int)" << endl;
-    } else if (l == "int" && r == "int*") {
-      cout << "; int + int*" << endl;
-      cout << "mult $5, $4" << endl;
-      cout << "mflo $5"
-           << "; $5 <- sizeof(int)" << endl;
+      default:
+        genStatement(s, procedure);
+        break;
     }
-    // l == "int" && r == "int"
-    cout << "add $3, $5, $3" << endl;
   }
+}
 
-  /* Subtraction */
-  else if (checkRule(root, {"expr", "expr", "MINUS", "term"}, true)) {
-    cout << "; expr expr MINUS term" << endl;
-    genCode(root->children[0], procedure);  // expr
-    push(3);
-    genCode(root->children[2], procedure);  // term
-    pop(5);
-
-    string l = typeChecker->typeOf(root->children[0], procedure);
-    string r = typeChecker->typeOf(root->children[2], procedure);
-
-    if (l == "int*" && r == "int") {
-      cout << "; int* - int" << endl;
-      cout << "mult $3, $4" << endl;
-      cout << "mflo $3"
-           << " ; sizeof(int)" << endl;
-      cout << "sub $3, $5, $3" << endl;
-    } else if (l == "int*" && r == "int*") {
-      cout << "; int* - int*" << endl;
-      cout << "sub $3, $5, $3" << endl;
-      cout << "divu $3, $4"
-           << " ; convert pointer address to int" << endl;
-      cout << "mflo $3" << endl;
-    } else {  // l == "int" && r == "int"
-      cout << "sub $3, $5, $3" << endl;
+// A statement without blocks of its own.
+void CodeGenerator::genStatement(const Stmt *s, const string &procedure) {
+  switch (s->kind) {
+    /* Deallocation */
+    case Stmt::DELETE: {
+      out << "; statement DELETE LBRACK RBRACK expr SEMI" << '\n';
+
+      string skipDeleteLabel =
+          procedure + "skipDelete" + to_string(labelCounter);
+      labelCounter++;
+
+      genCode(s->expr);
+      out << "beq $3, $11, " + skipDeleteLabel +
+                  " ; do NOT call delete on NULL"
+           << '\n';
+      out << "add $1, $3, $0 ; delete expects the address in $1" << '\n';
+      push(31);
+      out << "lis $5" << '\n';
+      out << ".word delete" << '\n';
+      out << "jalr $5" << '\n';
+      pop(31);
+      out << skipDeleteLabel << ":" << '\n';
+      break;
     }
-  }
 
-  /* Multiplication and division and mod */
-  else if (checkRule(root, {"term", "term", "STAR", "factor"}, true)) {
-    cout << "; term term STAR factor" << endl;
-    genCode(root->children[0], procedure);  // term
-    push(3);
-    genCode(root->children[2], procedure);  // factor
-    pop(5);
-    cout << "mult $5, $3" << endl;
-    cout << "mflo $3" << endl;
-  }
-
-  else if (checkRule(root, {"term", "term", "SLASH", "factor"}, true)) {
-    cout << "; term term SLASH factor" << endl;
-    genCode(root->children[0], procedure);  // term
-    push(3);
-    genCode(root->children[2], procedure);  // factor
-    pop(5);
-    cout << "div $5, $3" << endl;
-    cout << "mflo $3" << endl;
-  }
-
-  else if (checkRule(root, {"term", "term", "PCT", "factor"}, true)) {
-    cout << "; term term PCT factor" << endl;
-    genCode(root->children[0], procedure);  // term
-    push(3);
-    genCode(root->children[2], procedure);  // factor
-    pop(5);
-    cout << "div $5, $3" << endl;
-    cout << "mfhi $3" << endl;
-  }
+    /* Printing */
+    case Stmt::PRINTLN: {
+      out << "; statement PRINTLN LPAREN expr RPAREN SEMI" << '\n';
+
+      push(1);
+      genCode(s->expr);  // expr
+      out << "add $1 , $3 , $0" << '\n';
+      push(31);
+      out << "lis $5" << '\n';
+      out << ".word print" << '\n';
+      out << "jalr $5" << '\n';
+      pop(31);
+      pop(1);
+      break;
+    }
 
-  /* Procedure call */
-  else if (checkRule(root, {"factor", "ID", "LPAREN", "RPAREN"}, true)) {
-    cout << "; factor ID LPAREN RPAREN" << endl;
+    /* Assignment */
+    case Stmt::ASSIGN: {
+      out << "; statement lvalue BECOMES expr SEMI" << '\n';
 
-    string label = root->children[0]->lexeme;
-    push(29);
-    push(31);
+      genCode(s->target, true);  // lvalue
+      push(3);
+      genCode(s->expr);  // expr
+      pop(5);
 
-    cout << "lis $5" << endl;
-    cout << ".word " << label << endl;
-    cout << "jalr $5 " << endl;
+      // lvalue is the ID containing an address
+      // lvalue: $5, expr: $3
+      out << "sw $3, 0($5)" << '\n';
+      break;
+    }
 
-    pop(31);
-    pop(29);
+    default:
+      break;
   }
+}
 
-  else if (checkRule(root, {"factor", "ID", "LPAREN", "arglist", "RPAREN"},
-                     true)) {
-    cout << "; factor ID LPAREN arglist RPAREN" << endl;
-
-    string label = root->children[0]->lexeme;
-    push(29);
-    push(31);
-
-    // push params to stack
-    int paramNum = 0;
-    TreeNode *arglist = root->children[2];
-    while (true) {
-      if (checkRule(arglist, {"arglist", "expr"}, true)) {
-        genCode(arglist->children[0], procedure);  // expr
-        push(3);
-        paramNum++;
+// Generates code that leaves the value of expr in $3, or with address set,
+// the address of the lvalue expr.
+//
+// Expressions can nest as deep as they are long, so they are generated from
+// an explicit stack rather than by recursion. A frame's step counts the
+// operands generated so far; the code before, between and after them is
+// emitted as it advances.
+void CodeGenerator::genCode(const Expr *expr, bool address) {
+  struct Frame {
+    const Expr *expr;
+    bool address;
+    size_t step;
+  };
+  vector<Frame> frames{{expr, address, 0}};
+
+  while (!frames.empty()) {
+    Frame f = frames.back();
+    frames.back().step++;
+    const Expr *e = f.expr;
+    const Expr *next = nullptr;  // the operand to generate next, if any
+    bool nextAddress = false;
+
+    switch (e->kind) {
+      /* Literals and identifiers */
+      case Expr::VAR: {
+        const string &symbol = ast.name(e->lexeme);
+        int offset = symbols->symbols[e->slot].offset;
+
+        if (f.address) {
+          out << "; lvalue ID" << '\n';
+
+          out << "; address of ID(" << symbol << ")" << '\n';
+          out << "lis $3" << '\n';
+          out << ".word " << offset << '\n';
+          out << "add $3, $3, $29" << '\n';
+        } else {
+          out << "; factor ID" << '\n';
+
+          out << "lw $3, " << offset << "($29)"
+               << " ; load " << symbol << '\n';
+        }
         break;
-      } else {
-        // more arglsit remaining
-        genCode(arglist->children[0], procedure);  // expr
-        push(3);
-        paramNum++;
-
-        arglist = arglist->children[2];
       }
-    }
-
-    cout << "lis $5" << endl;
-    cout << ".word " << label << endl;
-    cout << "jalr $5 " << endl;
-
-    // free params from stack
-    cout << "lis $5" << endl;
-    cout << ".word " << paramNum * 4 << endl;
-    cout << "add $30, $30, $5" << endl;
-
-    pop(31);
-    pop(29);
-  }
-
-  /* Comparisons */
-  else if (checkRule(root, {"test", "expr", "LT", "expr"}, true)) {
-    cout << "; test expr LT expr" << endl;
-
-    genCode(root->children[0], procedure);
-    push(3);
-    genCode(root->children[2], procedure);
-    pop(5);
-
-    string slt = typeChecker->typeOf(root->children[0], procedure) == "int"
-                     ? "slt"
-                     : "sltu";
-    cout << slt << " $3, $5, $3" << endl;
-  }
-
-  else if (checkRule(root, {"test", "expr", "EQ", "expr"}, true)) {
-    cout << "; test expr EQ expr" << endl;
-
-    genCode(root->children[0], procedure);
-    push(3);
-    genCode(root->children[2], procedure);
-    pop(5);
-
-    string slt = typeChecker->typeOf(root->children[0], procedure) == "int"
-                     ? "slt"
-                     : "sltu";
-    cout << slt << " $6, $3, $5" << endl;
-    cout << slt << " $7, $5, $3" << endl;
-    cout << "add $3, $6, $7" << endl;
-    cout << "sub $3, $11, $3" << endl;
-  }
-
-  else if (checkRule(root, {"test", "expr", "NE", "expr"}, true)) {
-    cout << "; test expr NE expr" << endl;
-
-    genCode(root->children[0], procedure);
-    push(3);
-    genCode(root->children[2], procedure);
-    pop(5);
-
-    string slt = typeChecker->typeOf(root->children[0], procedure) == "int"
-                     ? "slt"
-                     : "sltu";
-    cout << slt << " $6, $3, $5" << endl;
-    cout << slt << " $7, $5, $3" << endl;
-    cout << "add $3, $6, $7" << endl;
-  }
-
-  else if (checkRule(root, {"test", "expr", "LE", "expr"}, true)) {
-    cout << "; test expr LE expr" << endl;
-
-    genCode(root->children[0], procedure);
-    push(3);
-    genCode(root->children[2], procedure);
-    pop(5);
-
-    string slt = typeChecker->typeOf(root->children[0], procedure) == "int"
-                     ? "slt"
-                     : "sltu";
-
-    cout << slt << " $3, $3, $5" << endl;
-    cout << "sub $3, $11, $3" << endl;
-  }
-
-  else if (checkRule(root, {"test", "expr", "GE", "expr"}, true)) {
-    cout << "; test expr GE expr" << endl;
 
-    genCode(root->children[0], procedure);
-    push(3);
-    genCode(root->children[2], procedure);
-    pop(5);
+      case Expr::NUM:
+        out << "; factor NUM" << '\n';
 
-    string slt = typeChecker->typeOf(root->children[0], procedure) == "int"
-                     ? "slt"
-                     : "sltu";
-
-    cout << slt << " $3, $5, $3" << endl;
-    cout << "sub $3, $11, $3" << endl;
-  }
-
-  else if (checkRule(root, {"test", "expr", "GT", "expr"}, true)) {
-    cout << "; test expr GT expr" << endl;
-
-    genCode(root->children[0], procedure);
-    push(3);
-    genCode(root->children[2], procedure);
-    pop(5);
-
-    string slt = typeChecker->typeOf(root->children[0], procedure) == "int"
-                     ? "slt"
-                     : "sltu";
-
-    cout << slt << " $3, $3, $5" << endl;
-  }
-
-  /* Control flow */
-  else if (checkRule(root,
-                     {"statement", "IF", "LPAREN", "test", "RPAREN", "LBRACE",
-                      "statements", "RBRACE", "ELSE", "LBRACE", "statements",
-                      "RBRACE"},
-                     true)) {
-    cout << "; statement IF LPAREN test RPAREN LBRACE statements RBRACE ELSE "
-            "LBRACE statements RBRACE"
-         << endl;
-
-    string endifLabel = procedure + "endif" + to_string(labelCounter);
-    string elseLabel = procedure + "else" + to_string(labelCounter);
-    labelCounter++;
-
-    genCode(root->children[2], procedure);  // test
-    cout << "bne $3, $11, " << elseLabel << endl;
-    genCode(root->children[5], procedure);
-    cout << "beq $0, $0, " << endifLabel << endl;
-    cout << elseLabel << ":" << endl;
-    genCode(root->children[9], procedure);
-    // end
-    cout << endifLabel << ":" << endl;
-  }
-
-  else if (checkRule(root,
-                     {
-                         "statement",
-                         "WHILE",
-                         "LPAREN",
-                         "test",
-                         "RPAREN",
-                         "LBRACE",
-                         "statements",
-                         "RBRACE",
-                     },
-                     true)) {
-    cout << "; statement WHILE LPAREN test RPAREN LBRACE statements RBRACE"
-         << endl;
-
-    string loopLabel = procedure + "loop" + to_string(labelCounter);
-    string endWhileLabel = procedure + "endWhile" + to_string(labelCounter);
-    labelCounter++;
-
-    cout << loopLabel << ":" << endl;
-    genCode(root->children[2], procedure);
-    cout << "bne $3, $11, " << endWhileLabel << endl;  // test is false
-    genCode(root->children[5], procedure);
-    cout << "beq $0, $0, " << loopLabel << endl;
-    cout << endWhileLabel << ":" << endl;
-  }
-
-  /* Allocation / Deallocation */
-  else if (checkRule(root, {"factor", "NEW", "INT", "LBRACK", "expr", "RBRACK"},
-                     true)) {
-    cout << "; factor NEW INT LBRACK expr RBRACK" << endl;
-    push(1);
-
-    genCode(root->children[3], procedure);
-    cout << "add $1, $3, $0 ; new procedure expects value in $1" << endl;
-    push(31);
-    cout << "lis $5" << endl;
-    cout << ".word new" << endl;
-    cout << "jalr $5" << endl;
-    pop(31);
-    cout << "bne $3, $0, 1; if call succeeded, skip next instruction" << endl;
-    cout << "add $3, $11, $0 ; if allocation fails, set $3 to NULL" << endl;
-
-    pop(1);
-  }
-
-  else if (checkRule(
-               root,
-               {"statement", "DELETE", "LBRACK", "RBRACK", "expr", "SEMI"},
-               true)) {
-    cout << "; statement DELETE LBRACK RBRACK expr SEMI" << endl;
-
-    string skipDeleteLabel = procedure + "skipDelete" + to_string(labelCounter);
-    labelCounter++;
-
-    genCode(root->children[3], procedure);
-    cout << "beq $3, $11, " + skipDeleteLabel + " ; do NOT call delete on NULL"
-         << endl;
-    cout << "add $1, $3, $0 ; delete expects the address in $1" << endl;
-    push(31);
-    cout << "lis $5" << endl;
-    cout << ".word delete" << endl;
-    cout << "jalr $5" << endl;
-    pop(31);
-    cout << skipDeleteLabel << ":" << endl;
-  }
-
-  /* Printing */
-  if (checkRule(root,
-                {"statement", "PRINTLN", "LPAREN", "expr", "RPAREN", "SEMI"},
-                true)) {
-    cout << "; statement PRINTLN LPAREN expr RPAREN SEMI" << endl;
-
-    push(1);
-    genCode(root->children[2], procedure);  // expr
-    cout << "add $1 , $3 , $0" << endl;
-    push(31);
-    cout << "lis $5" << endl;
-    cout << ".word print" << endl;
-    cout << "jalr $5" << endl;
-    pop(31);
-    pop(1);
-  }
-
-  /* Assignment */
-  else if (checkRule(root, {"statement", "lvalue", "BECOMES", "expr", "SEMI"},
-                     true)) {
-    cout << "; statement lvalue BECOMES expr SEMI" << endl;
-
-    genCode(root->children[0], procedure);  // lvalue
-    push(3);
-    genCode(root->children[2], procedure);  // expr
-    pop(5);
-
-    // lvalue is the ID containing an address
-    // lvalue: $5, expr: $3
-    cout << "sw $3, 0($5)" << endl;
-  }
-
-  else if (checkRule(root, {"lvalue", "ID"}, true)) {
-    cout << "; lvalue ID" << endl;
-
-    string symbol = root->children[0]->lexeme;
-    int offset = typeChecker->getSymbolOffset(symbol, procedure);
-
-    cout << "; address of ID(" << symbol << ")" << endl;
-    cout << "lis $3" << endl;
-    cout << ".word " << offset << endl;
-    cout << "add $3, $3, $29" << endl;
-  }
-
-  else if (checkRule(root, {"factor", "ID"}, true)) {
-    cout << "; factor ID" << endl;
-
-    string symbol = root->children[0]->lexeme;
-    int offset = typeChecker->getSymbolOffset(symbol, procedure);
-
-    cout << "lw $3, " << offset << "($29)"
-         << " ; load " << symbol << endl;
-  }
-
-  else if (checkRule(root, {"factor", "NUM"}, true)) {
-    cout << "; factor NUM" << endl;
-
-    string val = root->children[0]->lexeme;
-
-    cout << "lis $3" << endl;
-    cout << ".word " << val << endl;
-  }
-
-  else if (checkRule(root, {"factor", "NULL"}, true)) {
-    cout << "; factor NULL" << endl;
-
-    cout << "add $3, $0, $11 ; $11 is always 1" << endl;
-  }
-
-  /* Decl’ns */
-  else if (checkRule(root, {"dcls", "dcls", "dcl", "BECOMES", "NUM", "SEMI"},
-                     true)) {
-    cout << "; dcls dcls dcl BECOMES NUM SEMI" << endl;
-
-    genCode(root->children[0], procedure);
-
-    string symbol = root->children[1]->children[1]->lexeme;
-    string val = root->children[3]->lexeme;
-
-    cout << "; dcl " << symbol << " = " << val << endl;
-    cout << "lis $5" << endl;
-    cout << ".word " << val << endl;
-
-    // push $5 onto the stack
-    typeChecker->setSymbolOffset(symbol, procedure, offset);
-    push(5);  // push auto decrement offset
-  }
-
-  else if (checkRule(root, {"dcls", "dcls", "dcl", "BECOMES", "NULL", "SEMI"},
-                     true)) {
-    cout << "; dcls dcls dcl BECOMES NULL SEMI" << endl;
+        out << "lis $3" << '\n';
+        out << ".word " << ast.name(e->lexeme) << '\n';
+        break;
 
-    genCode(root->children[0], procedure);
+      case Expr::NULL_PTR:
+        out << "; factor NULL" << '\n';
 
-    string symbol = root->children[1]->children[1]->lexeme;
-    string val = root->children[3]->lexeme;
+        out << "add $3, $0, $11 ; $11 is always 1" << '\n';
+        break;
 
-    cout << "; dcl pointer " << symbol << " = " << val << endl;
-    cout << "lis $5" << endl;
-    cout << ".word 1" << endl;
+      /* Pointers */
+      case Expr::ADDRESS_OF:
+        if (f.step == 0) {
+          // not retreiving the value stored at the variable here yet
+          // Two outcomes: lvalue STAR factor (AMP cancel with STAR)
+          // lvalue ID (gets the address of ID)
+          out << "; factor AMP lvalue" << '\n';
+
+          next = e->left;
+          nextAddress = true;
+        }
+        break;
 
-    // push $5 onto the stack
-    typeChecker->setSymbolOffset(symbol, procedure, offset);
-    push(5);  // push auto decrement offset
-  }
+      case Expr::DEREF:
+        if (f.address) {
+          // factor AMP lvalue -> lvalue STAR factor cancels each other out
+          if (f.step == 0) {
+            out << "; lvalue STAR factor" << '\n';
+            next = e->left;
+          }
+        } else if (f.step == 0) {
+          out << "; factor STAR factor" << '\n';
+          next = e->left;
+        } else {
+          out << "lw $3, 0($3) ; $3 contains the loaded value" << '\n';
+        }
+        break;
 
-  /* Procedures */
-  if (checkRule(
-          root,
-          {"main", "INT", "WAIN", "LPAREN", "dcl", "COMMA", "dcl", "RPAREN",
-           "LBRACE", "dcls", "statements", "RETURN", "expr", "SEMI", "RBRACE"},
-          true)) {
-    cout << "; main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls "
-            "statements RETURN expr SEMI RBRACE"
-         << endl;
-    string procName = "wain";
-    string programType =
-        typeChecker->typeOf(root->children[3]->children[1], procName);
-    cout << "; Program type is: " << programType << endl;
-    cout << "wain:" << endl;
+      /* Allocation */
+      case Expr::NEW_ARRAY:
+        if (f.step == 0) {
+          out << "; factor NEW INT LBRACK expr RBRACK" << '\n';
+          push(1);
+          next = e->left;
+        } else {
+          out << "add $1, $3, $0 ; new procedure expects value in $1"
+               << '\n';
+          push(31);
+          out << "lis $5" << '\n';
+          out << ".word new" << '\n';
+          out << "jalr $5" << '\n';
+          pop(31);
+          out << "bne $3, $0, 1; if call succeeded, skip next instruction"
+               << '\n';
+          out << "add $3, $11, $0 ; if allocation fails, set $3 to NULL"
+               << '\n';
+
+          pop(1);
+        }
+        break;
 
-    // init
-    // If the first parameter to wain is of type int* (i.e., the generated code
-    // will be passed an array), then the size of this array must be in register
-    // $2 when init is called. Note that mips.array already puts the size of the
-    // array in register $2, so you only need to make sure that your generated
-    // code does not change $2 before it calls init.
-    // If the first parameter to wain is of type int, then register $2 must
-    // contain the value 0 (zero) when init is called.
-    push(31);
-    push(2);
+      /* Procedure call */
+      case Expr::CALL:
+        if (f.step == 0) {
+          if (e->args.empty()) {
+            out << "; factor ID LPAREN RPAREN" << '\n';
+          } else {
+            out << "; factor ID LPAREN arglist RPAREN" << '\n';
+          }
+          push(29);
+          push(31);
+        } else {
+          // push params to stack
+          push(3);
+        }
+
+        if (f.step < e->args.size()) {
+          next = e->args[f.step];
+        } else {
+          out << "lis $5" << '\n';
+          out << ".word " << ast.name(e->lexeme) << '\n';
+          out << "jalr $5 " << '\n';
+
+          if (!e->args.empty()) {
+            // free params from stack
+            out << "lis $5" << '\n';
+            out << ".word " << e->args.size() * 4 << '\n';
+            out << "add $30, $30, $5" << '\n';
+          }
+
+          pop(31);
+          pop(29);
+        }
+        break;
 
-    if (programType == "int") {
-      cout << "add $2, $0, $0" << endl;
+      case Expr::BINARY:
+        if (f.step == 0) {
+          const char *token = opToken(e->op);
+          if (isComparison(e->op)) {
+            out << "; test expr " << token << " expr" << '\n';
+          } else if (e->op == BinaryOp::PLUS || e->op == BinaryOp::MINUS) {
+            out << "; expr expr " << token << " term" << '\n';
+          } else {
+            out << "; term term " << token << " factor" << '\n';
+          }
+          next = e->left;
+        } else if (f.step == 1) {
+          push(3);
+          next = e->right;
+        } else {
+          pop(5);
+          genBinary(e);
+        }
+        break;
     }
-    cout << "lis $5" << endl;
-    cout << ".word init" << endl;
-    cout << "jalr $5" << endl;
-    pop(2);
-    pop(31);
-
-    cout << "; begin Prologue " << procName << endl;
-    cout << "sub $29 , $30 , $4 ; setup frame pointer" << endl;
 
-    offset = 0;
-    typeChecker->setSymbolOffset(root->children[3]->children[1]->lexeme,
-                                 procName, offset);
-    // param 1
-    push(1);  // push auto decrement offset
-
-    typeChecker->setSymbolOffset(root->children[5]->children[1]->lexeme,
-                                 procName, offset);
-    // param 2
-    push(2);  // push auto decrement offset
-
-    genCode(root->children[8], procName);   // dcls
-    genCode(root->children[9], procName);   // statements
-    genCode(root->children[11], procName);  // expr (return)
-
-    cout << "; Epilogue" << endl;
-    cout << "; deallocate parameters and local variables of wain" << endl;
-    offset = 0;
-    cout << "add $30, $29, $4" << endl;
-    cout << "jr $31" << endl;
-    cout << endl;
+    if (next) {
+      frames.push_back({next, nextAddress, 0});
+    } else {
+      frames.pop_back();  // done with e
+    }
   }
+}
 
-  else if (checkRule(root,
-                     {"procedure", "INT", "ID", "LPAREN", "params", "RPAREN",
-                      "LBRACE", "dcls", "statements", "RETURN", "expr", "SEMI",
-                      "RBRACE"},
-                     true)) {
-    cout << "; procedure INT ID LPAREN params RPAREN LBRACE dcls "
-            "statements RETURN expr SEMI RBRACE"
-         << endl;
-    string procName = root->children[1]->lexeme;
-    cout << "; Function : " << procName << endl;
-    cout << procName << ":" << endl;
-
-    cout << "; begin Prologue" << endl;
-    cout << "sub $29 , $30 , $4 ; assume caller-saves old frames" << endl;
-
-    // Handle arguments index (they already pushed into the stack by caller)
-    // Argument Index: 4, 8, ...
-    // Local Index: 0, -4, -8, ...
-    offset = typeChecker->getSignature(procName).size() * 4;
-    TreeNode *params = root->children[3];
-    while (true) {
-      if (checkRule(params, {"params"}, true)) {
-        // no params
-        break;
-      } else if (checkRule(params, {"params", "paramlist"}, true)) {
-        // has param
-        params = params->children[0];
-      } else if (checkRule(params, {"paramlist", "dcl"}, true)) {
-        // last param
-        typeChecker->setSymbolOffset(params->children[0]->children[1]->lexeme,
-                                     procName, offset);
-        offset -= 4;
-        break;
-      } else if (checkRule(params, {"paramlist", "dcl", "COMMA", "paramlist"},
-                           true)) {
-        // more params remaining
-        typeChecker->setSymbolOffset(params->children[0]->children[1]->lexeme,
-                                     procName, offset);
-        offset -= 4;
-
-        params = params->children[2];
+// Combines the left operand of expr, in $5, and the right, in $3, into $3.
+void CodeGenerator::genBinary(const Expr *expr) {
+  // The operands' types were tagged on them by the type checker. Comparisons
+  // of pointers are unsigned.
+  TypeId l = expr->left->type;
+  TypeId r = expr->right->type;
+  const char *slt = l == TypeTable::INT ? "slt" : "sltu";
+
+  switch (expr->op) {
+    /* Addition */
+    case BinaryOp::PLUS: {
+      // $3 term, $5 expr
+      if (l == TypeTable::INT_PTR && r == TypeTable::INT) {
+        out << "; int* + int" << '\n';
+        out << "mult $3, $4" << '\n';
+        out << "mflo $3"
+             << " ; $3 <- sizeof(int)" << '\n';
+      } else if (l == TypeTable::INT && r == TypeTable::INT_PTR) {
+        out << "; int + int*" << '\n';
+        out << "mult $5, $4" << '\n';
+        out << "mflo $5"
+             << "; $5 <- sizeof(int)" << '\n';
       }
+      // l == INT && r == INT
+      out << "add $3, $5, $3" << '\n';
+      break;
     }
 
-    // It should be that offset = 0 here;
-    assert(offset == 0);
-
-    genCode(root->children[6], procName);  // dcls (record the local variables)
-    genCode(root->children[7], procName);  // statements
-    genCode(root->children[9], procName);  // expr
+    /* Subtraction */
+    case BinaryOp::MINUS: {
+      if (l == TypeTable::INT_PTR && r == TypeTable::INT) {
+        out << "; int* - int" << '\n';
+        out << "mult $3, $4" << '\n';
+        out << "mflo $3"
+             << " ; sizeof(int)" << '\n';
+        out << "sub $3, $5, $3" << '\n';
+      } else if (l == TypeTable::INT_PTR && r == TypeTable::INT_PTR) {
+        out << "; int* - int*" << '\n';
+        out << "sub $3, $5, $3" << '\n';
+        out << "divu $3, $4"
+             << " ; convert pointer address to int" << '\n';
+        out << "mflo $3" << '\n';
+      } else {  // l == INT && r == INT
+        out << "sub $3, $5, $3" << '\n';
+      }
+      break;
+    }
 
-    cout << "; Epilogue" << endl;
-    cout << "; deallocate parameters and local variables of wain" << endl;
-    offset = 0;  // resore offset
-    cout << "add $30, $29, $4" << endl;
-    cout << "jr $31" << endl;
-    cout << endl;
+    /* Multiplication and division and mod */
+    case BinaryOp::STAR:
+      out << "mult $5, $3" << '\n';
+      out << "mflo $3" << '\n';
+      break;
+
+    case BinaryOp::SLASH:
+      out << "div $5, $3" << '\n';
+      out << "mflo $3" << '\n';
+      break;
+
+    case BinaryOp::PCT:
+      out << "div $5, $3" << '\n';
+      out << "mfhi $3" << '\n';
+      break;
+
+    /* Comparisons */
+    case BinaryOp::LT:
+      out << slt << " $3, $5, $3" << '\n';
+      break;
+
+    case BinaryOp::EQ:
+      out << slt << " $6, $3, $5" << '\n';
+      out << slt << " $7, $5, $3" << '\n';
+      out << "add $3, $6, $7" << '\n';
+      out << "sub $3, $11, $3" << '\n';
+      break;
+
+    case BinaryOp::NE:
+      out << slt << " $6, $3, $5" << '\n';
+      out << slt << " $7, $5, $3" << '\n';
+      out << "add $3, $6, $7" << '\n';
+      break;
+
+    case BinaryOp::LE:
+      out << slt << " $3, $3, $5" << '\n';
+      out << "sub $3, $11, $3" << '\n';
+      break;
+
+    case BinaryOp::GE:
+      out << slt << " $3, $5, $3" << '\n';
+      out << "sub $3, $11, $3" << '\n';
+      break;
+
+    case BinaryOp::GT:
+      out << slt << " $3, $3, $5" << '\n';
+      break;
   }
 }
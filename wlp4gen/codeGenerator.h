@@ -8,22 +8,43 @@
 #include <unordered_map>
 #include <vector>
 
+#include "threadPool.h"
 #include "typeChecker.h"
 
 using namespace std;
 
+// Writes the MIPS assembly for a type-checked Ast to out as it is
+// constructed, with a pool generating the procedures at the same time on its
+// threads. Procedures checked later, as a streamed program's are, are
+// written by genProcedure, in source order.
 class CodeGenerator {
  public:
-  CodeGenerator(TreeNode *root, TypeChecker *TC);
+  CodeGenerator(const Ast &ast, TypeChecker *TC, ostream &out,
+                ThreadPool *pool = nullptr);
   virtual ~CodeGenerator();
 
+  void genProcedure(const Procedure *proc);
+
  private:
+  const Ast &ast;
   TypeChecker *typeChecker;
+  ostream &out;
   int offset;  // reset to 0 at every procedure or wain, decrement for every dcl
                // by 4
   int labelCounter;
+  ProcedureSymbols *symbols;  // the procedure being generated
+
+  // A generator for procedures alone, numbering its labels from firstLabel.
+  CodeGenerator(const Ast &ast, TypeChecker *TC, ostream &out,
+                int firstLabel);
+  void genConcurrently(ThreadPool &pool);
   void genPrologue();
-  void genCode(TreeNode *root, string procedure);
+  void genDcls(const NodeList<Dcl> &dcls, size_t firstSlot);
+  void genStatements(const NodeList<Stmt> &statements,
+                     const string &procedure);
+  void genStatement(const Stmt *s, const string &procedure);
+  void genCode(const Expr *expr, bool address = false);
+  void genBinary(const Expr *expr);
   void push(int reg);
   void pop(int reg);
 };
@@ -1,6 +1,7 @@
 #include "typeChecker.h"
 
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <sstream>
 #include <stack>
@@ -9,603 +10,505 @@
 
 using namespace std;
 
-bool checkRule(TreeNode *root, vector<string> rule, bool isStrict = true) {
-  if (isStrict && root->children.size() + 1 != rule.size()) {
-    return false;
-  }
-
-  if (root->val != rule[0]) {
-    return false;
+TypeChecker::TypeChecker(const Ast &ast, ThreadPool *pool) : ast(ast) {
+  buildSymbolTable();
+  if (pool) {
+    checkConcurrently(*pool);
+    return;
   }
-
-  for (int i = 0; i < rule.size() - 1; i++) {
-    if (root->children[i]->val != rule[i + 1]) {
-      return false;
-    }
+  for (const Procedure *proc : ast.procedures) {
+    check(proc);
   }
-
-  return true;
-}
-
-// unordered_map<procedure_name, pair<vector<parameter_type>,
-// unordered_map<variable_name, type>>>
-TypeChecker::TypeChecker(TreeNode *root) {
-  buildSymbolTable(root);
-  validateWithType(root, "");
 };
 
 TypeChecker::~TypeChecker() {}
 
-void TypeChecker::buildSymbolTable(TreeNode *root) {
-  if (!root) {
-    return;
+void TypeChecker::buildSymbolTable() {
+  // Every procedure is declared first, in source order. Declaring one
+  // resolves the names in its body against the procedures declared so far,
+  // so a procedure can only call those defined before it (and itself). The
+  // constructor type checks the bodies only once all are declared, in turn
+  // or, with a pool, concurrently.
+  for (const Procedure *proc : ast.procedures) {
+    declare(proc);
   }
+}
 
-  if (root->val == "procedure") {
-    string procName =
-        root->children[1]->lexeme;  // procedure name, could be wain
-
-    SignatureInnerSymbolTable p;
-    buildSigniture(root->children[3], p);
-    buildInnerTable(root->children[6], p);
-    if (symbolTable.find(procName) == symbolTable.end()) {
-      symbolTable[procName] = p;
-    } else {
-      redefinitionError("redefinition of procedure" + procName);
-    }
+// Once every signature is in the symbol table, the bodies are independent:
+// checking one only reads the tables, and writes nothing but the types and
+// slots of its own expressions. Each is checked as a task of its own, and
+// the first error in source order is the one reported, as it would be had
+// they been checked in turn.
+void TypeChecker::checkConcurrently(ThreadPool &pool) {
+  vector<future<string>> errors;
+  for (const Procedure *proc : ast.procedures) {
+    errors.push_back(pool.submit([this, proc]() {
+      try {
+        check(proc);
+      } catch (TypeError &e) {
+        return e.what();
+      }
+      return string();
+    }));
+  }
 
-    validateWithSymbolTable(root->children[7],
-                            procName);  // validate statements
-    validateWithSymbolTable(root->children[9],
-                            procName);  // validate return
-  } else if (root->val == "main") {
-    string procName =
-        root->children[1]->lexeme;  // procedure name, could be wain
-
-    SignatureInnerSymbolTable p;
-    buildSigniture(root, p);
-    buildInnerTable(root->children[8], p);
-    if (symbolTable.find(procName) == symbolTable.end()) {
-      symbolTable[procName] = p;
-    } else {
-      redefinitionError("redefinition of procedure " + procName);
+  string first;
+  for (future<string> &error : errors) {
+    string e = error.get();
+    if (first.empty()) {
+      first = e;
     }
-
-    validateWithSymbolTable(root->children[9],
-                            procName);  // validate statements
-    validateWithSymbolTable(root->children[11],
-                            procName);  // validate return
   }
-
-  for (int i = 0; i < root->children.size(); i++) {
-    buildSymbolTable(root->children[i]);
+  if (!first.empty()) {
+    throw TypeError(first);
   }
 }
 
-void TypeChecker::buildSigniture(TreeNode *root,
-                                 SignatureInnerSymbolTable &SISTPair) {
-  if (!root) {
-    return;
+void TypeChecker::declare(const Procedure *proc) {
+  ProcedureSymbols p;
+  p.name = proc->name;
+  for (const Dcl *param : proc->params) {
+    p.signature.push_back(param->type);  // record signiture
+    addSymbol(param, p);
   }
-
-  if (root->val == "dcl") {
-    string t = "";
-    for (auto s : (root->children[0]->children)) {
-      t += s->lexeme;
-    }
-
-    SISTPair.first.push_back(t);  // record signiture
-    if (SISTPair.second.find(root->children[1]->lexeme) ==
-        SISTPair.second.end()) {
-      SISTPair.second[root->children[1]->lexeme].first = t;  // record variable
-    } else {
-      redefinitionError("redefinition of variable " +
-                        root->children[1]->lexeme);
-    }
-
-    return;
+  for (const Dcl *dcl : proc->dcls) {
+    addSymbol(dcl, p);
   }
-
-  for (int i = 0; i < root->children.size(); i++) {
-    if (root->children[i]->val == "RPAREN") {
-      // end of signiture
-      return;
-    }
-    buildSigniture(root->children[i], SISTPair);
+  if (findProcedure(proc->name)) {
+    redefinitionError("redefinition of procedure" + ast.name(proc->name));
   }
+  procedureIds[proc->name] = procedures.size();
+  procedures.push_back(move(p));
+
+  validateWithSymbolTable(proc->statements, procedures.back());
+  validateWithSymbolTable(proc->result, procedures.back());
 }
 
-void TypeChecker::buildInnerTable(TreeNode *root,
-                                  SignatureInnerSymbolTable &SISTPair) {
-  if (!root) {
-    return;
-  }
+void TypeChecker::check(const Procedure *proc) {
+  validateWithType(proc, symbolsOf(proc));
+}
 
-  if (root->val == "dcl") {
-    string t = "";
-    for (auto s : (root->children[0]->children)) {
-      t += s->lexeme;
+bool TypeChecker::callsDeclared(const Procedure *proc) {
+  vector<const Stmt *> stmts;
+  vector<const Expr *> exprs{proc->result};
+  pushReversed(stmts, proc->statements);
+  while (!stmts.empty()) {
+    const Stmt *s = stmts.back();
+    stmts.pop_back();
+    if (s->kind == Stmt::ASSIGN) {
+      exprs.push_back(s->target);
+    }
+    exprs.push_back(s->expr);
+    pushReversed(stmts, s->elseBody);
+    pushReversed(stmts, s->body);
+  }
+  while (!exprs.empty()) {
+    const Expr *e = exprs.back();
+    exprs.pop_back();
+    if (e->kind == Expr::CALL && !findProcedure(e->lexeme)) {
+      return false;
     }
-
-    if (SISTPair.second.find(root->children[1]->lexeme) ==
-        SISTPair.second.end()) {
-      SISTPair.second[root->children[1]->lexeme].first = t;  // record variable
-    } else {
-      redefinitionError("redefinition of variable " +
-                        root->children[1]->lexeme);
+    for (size_t i = 0; i < e->numOperands(); i++) {
+      exprs.push_back(e->operand(i));
     }
-    return;
-  }
-
-  for (int i = 0; i < root->children.size(); i++) {
-    buildInnerTable(root->children[i], SISTPair);
   }
+  return true;
 }
 
-bool TypeChecker::hasProcedure(string procedure) {
-  if (symbolTable.find(procedure) != symbolTable.end()) {
-    return true;
+void TypeChecker::addSymbol(const Dcl *dcl, ProcedureSymbols &procedure) {
+  if (findSymbol(procedure, dcl->name) == NO_SLOT) {
+    // record variable
+    procedure.slots[dcl->name] = procedure.symbols.size();
+    procedure.symbols.push_back({dcl->name, dcl->type, 0});
   } else {
-    return false;
+    redefinitionError("redefinition of variable " + ast.name(dcl->name));
   }
 }
 
-bool TypeChecker::hasSymbol(string name, string procedure) {
-  if (symbolTable[procedure].second.find(name) !=
-      symbolTable[procedure].second.end()) {
-    return true;
-  } else {
-    return false;
-  }
+const ProcedureSymbols *TypeChecker::findProcedure(uint32_t name) const {
+  auto it = procedureIds.find(name);
+  return it == procedureIds.end() ? nullptr : &procedures[it->second];
 }
 
-string TypeChecker::getSymbolType(string name, string procedure) {
-  return symbolTable[procedure].second[name].first;
+uint32_t TypeChecker::findSymbol(const ProcedureSymbols &procedure,
+                                 uint32_t name) {
+  auto it = procedure.slots.find(name);
+  return it == procedure.slots.end() ? NO_SLOT : it->second;
 }
 
-const vector<string> &TypeChecker::getSignature(string procedure) {
-  return symbolTable[procedure].first;
+ProcedureSymbols &TypeChecker::symbolsOf(const Procedure *proc) {
+  return procedures[procedureIds.at(proc->name)];
 }
 
-string TypeChecker::getRule(TreeNode *root) {
-  string rule = "";
-  for (TreeNode *node : root->children) {
-    rule += node->val + " ";
-  }
-  return rule;
-}
+// The walks below use explicit stacks: blocks nest and expressions grow as
+// deep as the program likes, so recursion could overflow the call stack.
 
-int TypeChecker::getSymbolOffset(string name, string procedure) {
-  if (symbolTable.find(procedure) == symbolTable.end() ||
-      symbolTable[procedure].second.find(name) ==
-          symbolTable[procedure].second.end()) {
-    accessViolationError("procedure " + procedure + " or variable " + name +
-                         " does not exist!");
-  }
-  return symbolTable[procedure].second[name].second;
-}
-
-void TypeChecker::setSymbolOffset(string name, string procedure, int offset) {
-  if (symbolTable.find(procedure) == symbolTable.end() ||
-      symbolTable[procedure].second.find(name) ==
-          symbolTable[procedure].second.end()) {
-    accessViolationError("procedure: " + procedure + ", or variable: " + name +
-                         ", does not exist!");
+void TypeChecker::validateWithSymbolTable(const NodeList<Stmt> &statements,
+                                          const ProcedureSymbols &procedure) {
+  vector<const Stmt *> stack;
+  pushReversed(stack, statements);
+  while (!stack.empty()) {
+    const Stmt *s = stack.back();
+    stack.pop_back();
+    if (s->kind == Stmt::ASSIGN) {
+      validateWithSymbolTable(s->target, procedure);
+    }
+    validateWithSymbolTable(s->expr, procedure);
+    pushReversed(stack, s->elseBody);
+    pushReversed(stack, s->body);
   }
-  symbolTable[procedure].second[name].second = offset;
 }
 
-void TypeChecker::validateWithSymbolTable(TreeNode *root, string procedure) {
-  if (!root) {
-    return;
-  }
-
-  if (checkRule(root, {"lvalue", "ID"}, true)) {
-    string variableName = root->children[0]->lexeme;
-    if (hasSymbol(variableName, procedure)) {
-      return;
-    } else {
-      undeclaredError("variable " + variableName +
-                      " is used without being declared");
-    }
-  } else if (checkRule(root, {"factor", "ID"}, false)) {
-    if (root->children.size() == 1) {
-      string variableName = root->children[0]->lexeme;
-      if (hasSymbol(variableName, procedure)) {
-        return;
-      } else {
-        undeclaredError("variable " + variableName +
-                        " is used without being declared");
+void TypeChecker::validateWithSymbolTable(const Expr *expr,
+                                          const ProcedureSymbols &procedure) {
+  vector<const Expr *> stack{expr};
+  while (!stack.empty()) {
+    const Expr *e = stack.back();
+    stack.pop_back();
+    switch (e->kind) {
+      case Expr::VAR: {
+        if (findSymbol(procedure, e->lexeme) == NO_SLOT) {
+          undeclaredError("variable " + ast.name(e->lexeme) +
+                          " is used without being declared");
+        }
+        break;
       }
-    } else if (root->children.size() > 2 &&
-               root->children[1]->val == "LPAREN") {
-      string procName = root->children[0]->lexeme;
-      if (hasProcedure(procName)) {
-        return;
-      } else {
-        undeclaredError("procedure " + procName +
-                        " is used without being declared");
+      case Expr::CALL: {
+        // The arguments are left to typeOf.
+        if (!findProcedure(e->lexeme)) {
+          undeclaredError("procedure " + ast.name(e->lexeme) +
+                          " is used without being declared");
+        }
+        break;
       }
-    } else {
-      unknownError(
-          "This error is not suppose to happpen when validating with symbol "
-          "table!");
+      default:
+        for (size_t i = e->numOperands(); i-- > 0;) {
+          stack.push_back(e->operand(i));
+        }
+        break;
     }
   }
-
-  for (int i = 0; i < root->children.size(); i++) {
-    validateWithSymbolTable(root->children[i], procedure);
-  }
 }
 
-void TypeChecker::validateWithType(TreeNode *root, string procedure) {
-  if (debug) {
-    if (root->children.size() != 0) {
-      cout << "==============" << endl;
-      cout << root->val << " ";
-      for (int i = 0; i < root->children.size(); i++) {
-        cout << root->children[i]->val << " ";
-      }
-      cout << endl;
-    } else {
-      // cout << root->val << " " << root->lexeme << endl;
-    }
-  }
-
-  /* Comparisons */
-  if (checkRule(root, {"test", "expr", "EQ", "expr"}, true) ||
-      checkRule(root, {"test", "expr", "NE", "expr"}, true) ||
-      checkRule(root, {"test", "expr", "LT", "expr"}, true) ||
-      checkRule(root, {"test", "expr", "LE", "expr"}, true) ||
-      checkRule(root, {"test", "expr", "GE", "expr"}, true) ||
-      checkRule(root, {"test", "expr", "GT", "expr"}, true)) {
-    string l = typeOf(root->children[0], procedure);
-    string r = typeOf(root->children[2], procedure);
-    if (l != r) {
-      typeCorrectnessError("comparison between " + l + " and " + r);
+void TypeChecker::validateWithType(const Procedure *proc,
+                                   const ProcedureSymbols &procedure) {
+  if (proc->isMain) {
+    if (proc->params[1]->type != TypeTable::INT) {
+      typeCorrectnessError("wain must have int as second argument");
     }
   }
 
-  /* Control flow */
-  // Composition of welltyped subelement
-
-  /* Deallocation */
-  else if (checkRule(
-               root,
-               {"statement", "DELETE", "LBRACK", "RBRACK", "expr", "SEMI"},
-               true)) {
-    string exprType = typeOf(root->children[3], procedure);  // expr
-    if (exprType != "int*") {
-      typeCorrectnessError("delete [] must use int* parameter, instead " +
-                           exprType + " is given");
-    }
-  }
+  validateWithType(proc->statements, procedure);
 
-  /* Printing */
-  else if (checkRule(
-               root,
-               {"statement", "PRINTLN", "LPAREN", "expr", "RPAREN", "SEMI"},
-               true)) {
-    string exprType = typeOf(root->children[2], procedure);  // expr
-    if (exprType != "int") {
-      typeCorrectnessError("println must use int parameter, instead " +
-                           exprType + " is given");
-    }
-  }
-
-  /* Assignment */
-  else if (checkRule(root, {"statement", "lvalue", "BECOMES", "expr", "SEMI"},
-                     true)) {
-    string l = typeOf(root->children[0], procedure);
-    string r = typeOf(root->children[2], procedure);
-    if (l != r) {
-      typeCorrectnessError("cannot assign " + r + " to " + l);
+  if (typeOf(proc->result, procedure) != TypeTable::INT) {
+    if (proc->isMain) {
+      typeCorrectnessError("wain must return int");
+    } else {
+      typeCorrectnessError("procedure " + ast.name(proc->name) +
+                           " must return int");
     }
   }
 
-  /* Sequencing */
-  // Composition of welltyped subelement
-
   /* Decl’ns */
-  else if (checkRule(root, {"dcls", "dcls", "dcl", "BECOMES", "NUM", "SEMI"},
-                     true)) {
-    string dclType = typeOf(root->children[1], procedure);
-    if (dclType != "int") {
-      typeCorrectnessError("cannot assign NUM to " + dclType);
-    }
-  }
-
-  else if (checkRule(root, {"dcls", "dcls", "dcl", "BECOMES", "NULL", "SEMI"},
-                     true)) {
-    string dclType = typeOf(root->children[1], procedure);
-    if (dclType != "int*") {
-      typeCorrectnessError("cannot assign NULL to " + dclType);
-    }
-  }
-
-  /* Procedures */
-  else if (checkRule(root,
-                     {"main", "INT", "WAIN", "LPAREN", "dcl", "COMMA", "dcl",
-                      "RPAREN", "LBRACE", "dcls", "statements", "RETURN",
-                      "expr", "SEMI", "RBRACE"},
-                     true)) {
-    procedure = "wain";
-
-    string second = typeOf(root->children[5],
-                           procedure);  // second parameter in wain
-    if (second != "int") {
-      typeCorrectnessError("wain must have int as second argument");
+  for (const Dcl *dcl : proc->dcls) {
+    TypeId dclType = dcl->type;
+    if (dcl->init->kind == Expr::NUM && dclType != TypeTable::INT) {
+      typeCorrectnessError("cannot assign NUM to " + types.name(dclType));
+    } else if (dcl->init->kind == Expr::NULL_PTR &&
+               dclType != TypeTable::INT_PTR) {
+      typeCorrectnessError("cannot assign NULL to " + types.name(dclType));
     }
-
-    validateWithType(root->children[9], procedure);  // statements
-
-    string returnValue = typeOf(root->children[11], procedure);  // return
-    if (returnValue != "int") {
-      typeCorrectnessError("wain must return int");
-    }
-  } else if (checkRule(root,
-                       {"procedure", "INT", "ID", "LPAREN", "params", "RPAREN",
-                        "LBRACE", "dcls", "statements", "RETURN", "expr",
-                        "SEMI", "RBRACE"},
-                       true)) {
-    procedure = root->children[1]->lexeme;
-
-    validateWithType(root->children[7], procedure);  // statements
-
-    string returnValue =
-        typeOf(root->children[9], procedure);  // return value (expr)
-    if (returnValue != "int") {
-      string procedureName = root->children[1]->lexeme;
-      typeCorrectnessError("procedure " + procedureName + " must return int");
-    }
-  }
-
-  for (int i = 0; i < root->children.size(); i++) {
-    validateWithType(root->children[i], procedure);
-  }
-}
-
-void TypeChecker::getArgTypeList(TreeNode *root, string procedure,
-                                 vector<string> &argTypeList) {
-  if (checkRule(root, {"arglist", "expr"}, true)) {
-    string exprType = typeOf(root->children[0], procedure);
-    argTypeList.push_back(exprType);
-  } else if (checkRule(root, {"arglist", "expr", "COMMA", "arglist"}, true)) {
-    string exprType = typeOf(root->children[0], procedure);
-    argTypeList.push_back(exprType);
-    getArgTypeList(root->children[2], procedure, argTypeList);
-  } else {
-    typeCorrectnessError("cannot parse arguments: " + getRule(root));
   }
 }
 
-string TypeChecker::typeOf(TreeNode *root, string procedure) {
-  if (debug) {
-    cout << "Typeof at ";
-    if (root->children.size() != 0) {
-      cout << root->val << " ";
-      for (int i = 0; i < root->children.size(); i++) {
-        cout << root->children[i]->val << " ";
+void TypeChecker::validateWithType(const NodeList<Stmt> &statements,
+                                   const ProcedureSymbols &procedure) {
+  vector<const Stmt *> stack;
+  pushReversed(stack, statements);
+  while (!stack.empty()) {
+    const Stmt *s = stack.back();
+    stack.pop_back();
+    switch (s->kind) {
+      /* Assignment */
+      case Stmt::ASSIGN: {
+        TypeId l = typeOf(s->target, procedure);
+        TypeId r = typeOf(s->expr, procedure);
+        if (l != r) {
+          typeCorrectnessError("cannot assign " + types.name(r) + " to " +
+                               types.name(l));
+        }
+        break;
       }
-      cout << endl;
-    } else {
-      cout << root->val << " " << root->lexeme << endl;
-    }
-  }
-  string type = "";
-
-  /* Literals and identifiers */
-  if (checkRule(root, {"ID"}, false)) {
-    type = getSymbolType(root->lexeme, procedure);
-  }
-
-  else if (checkRule(root, {"NUM"}, false)) {
-    type = "int";
-  }
-
-  else if (checkRule(root, {"NULL"}, false)) {
-    type = "int*";
-  }
-
-  // singleton
-  else if (checkRule(root, {"expr", "term"}, true) ||
-           checkRule(root, {"term", "factor"}, true) ||
-           checkRule(root, {"lvalue", "ID"}, true) ||
-           checkRule(root, {"factor", "ID"}, true) ||
-           checkRule(root, {"factor", "NUM"}, true) ||
-           checkRule(root, {"factor", "NULL"}, true)) {
-    type = typeOf(root->children[0], procedure);
-  }
-
-  // declaration
-  else if (checkRule(root, {"dcl", "type", "ID"}, true)) {
-    type = typeOf(root->children[1], procedure);
-  }
-
-  /* Parenthesized expressions */
-  else if (checkRule(root, {"factor", "LPAREN", "expr", "RPAREN"}, true) ||
-           checkRule(root, {"lvalue", "LPAREN", "lvalue", "RPAREN"}, true)) {
-    type = typeOf(root->children[1], procedure);
-  }
-
-  /* Pointers */
-  else if (checkRule(root, {"factor", "AMP", "lvalue"}, true)) {
-    string LvalueType = typeOf(root->children[1], procedure);
-    if (LvalueType != "int")
-      typeDerivationError("& must be used with int");
-    else
-      type = "int*";
-  }
-
-  else if (checkRule(root, {"lvalue", "STAR", "factor"}, true) ||
-           checkRule(root, {"factor", "STAR", "factor"}, true)) {
-    string factorType = typeOf(root->children[1], procedure);
 
-    if (factorType == "int") {
-      typeDerivationError("cannot deference an int");
-    } else {
-      type = "int";  // deferenced from int*
-    }
-  }
-
-  else if (checkRule(root, {"factor", "NEW", "INT", "LBRACK", "expr", "RBRACK"},
-                     true)) {
-    string exprType = typeOf(root->children[3], procedure);
-
-    if (exprType != "int") {
-      typeDerivationError("new [] must use int parameter, instead " + exprType +
-                          " is given");
-    }
-
-    type = "int*";
-  }
+      /* Control flow */
+      // Composition of welltyped subelement
+      case Stmt::IF:
+      case Stmt::WHILE: {
+        TypeId l = typeOf(s->expr->left, procedure);
+        TypeId r = typeOf(s->expr->right, procedure);
+        if (l != r) {
+          typeCorrectnessError("comparison between " + types.name(l) +
+                               " and " + types.name(r));
+        }
+        pushReversed(stack, s->elseBody);
+        pushReversed(stack, s->body);
+        break;
+      }
 
-  /* Addition */
-  else if (checkRule(root, {"expr", "expr", "PLUS", "term"}, true)) {
-    string l = typeOf(root->children[0], procedure);  // expr
-    string r = typeOf(root->children[2], procedure);  // term
-    if (l == "int" && r == "int") {
-      type = "int";
-    } else if (l == "int*" && r == "int") {
-      type = "int*";
-    } else if (l == "int" && r == "int*") {
-      type = "int*";
-    } else {  // (l == "int*" && r == "int*") {
-      typeDerivationError("cannot add two int*");
-    }
-  }
+      /* Printing */
+      case Stmt::PRINTLN: {
+        TypeId exprType = typeOf(s->expr, procedure);
+        if (exprType != TypeTable::INT) {
+          typeCorrectnessError("println must use int parameter, instead " +
+                               types.name(exprType) + " is given");
+        }
+        break;
+      }
 
-  /* Subtraction */
-  else if (checkRule(root, {"expr", "expr", "MINUS", "term"}, true)) {
-    string l = typeOf(root->children[0], procedure);  // expr
-    string r = typeOf(root->children[2], procedure);  // term
-    if (l == "int" && r == "int") {
-      type = "int";
-    } else if (l == "int*" && r == "int") {
-      type = "int*";
-    } else if (l == "int" && r == "int*") {
-      typeDerivationError("cannot subtract int* from int");
-    } else {  // (l == "int*" && r == "int*") {
-      type = "int";
+      /* Deallocation */
+      case Stmt::DELETE: {
+        TypeId exprType = typeOf(s->expr, procedure);
+        if (exprType != TypeTable::INT_PTR) {
+          typeCorrectnessError("delete [] must use int* parameter, instead " +
+                               types.name(exprType) + " is given");
+        }
+        break;
+      }
     }
   }
+}
 
-  /* Multiplication and division and mod */
-  else if (checkRule(root, {"term", "term", "STAR", "factor"}, true) ||
-           checkRule(root, {"term", "term", "SLASH", "factor"}, true) ||
-           checkRule(root, {"term", "term", "PCT", "factor"}, true)) {
-    if (typeOf(root->children[0], procedure) != "int" ||
-        typeOf(root->children[2], procedure) != "int") {
-      string op = root->children[1]->lexeme;
-      typeDerivationError("invalid operation: " + op +
-                          " cannot be used with int* " + " in " + procedure);
+TypeId TypeChecker::typeOf(Expr *expr, const ProcedureSymbols &procedure) {
+  // A frame per expression being typed, counting the operands started so far.
+  // Finished operands leave their types on types for their parent.
+  struct Frame {
+    Expr *expr;
+    size_t started;
+  };
+  vector<Frame> frames;
+  vector<TypeId> operandTypes;
+
+  auto begin = [&](Expr *e) {
+    if (e->type != TypeTable::NONE) {
+      operandTypes.push_back(e->type);
+      return;
     }
-
-    type = "int";
-  }
-
-  /* Procedure call */
-  else if (checkRule(root, {"factor", "ID", "LPAREN", "RPAREN"}, true)) {
-    string procName = root->children[0]->lexeme;
-
-    if (hasSymbol(procName, procedure)) {
+    if (e->kind == Expr::CALL &&
+        findSymbol(procedure, e->lexeme) != NO_SLOT) {
       variableOvershadowProcedureError(
-          "procedure " + procName +
-          " is overshadowed by variable with the same name, therefore cannot "
-          "be called.");
-    }
-    if (getSignature(procName).size() != 0) {
-      typeDerivationError("procedure takes in 0 parameters");
+          "procedure " + ast.name(e->lexeme) +
+          " is overshadowed by variable with the same name, therefore "
+          "cannot be called.");
+    }
+    frames.push_back({e, 0});
+  };
+
+  begin(expr);
+  while (!frames.empty()) {
+    Frame &f = frames.back();
+    Expr *e = f.expr;
+    size_t numOperands = e->numOperands();
+    if (f.started < numOperands) {
+      // * / and % give up on a pointer before looking at their right operand.
+      if (f.started == 1 && e->kind == Expr::BINARY &&
+          (e->op == BinaryOp::STAR || e->op == BinaryOp::SLASH ||
+           e->op == BinaryOp::PCT) &&
+          operandTypes.back() != TypeTable::INT) {
+        typeDerivationError("invalid operation: " + string(opLexeme(e->op)) +
+                            " cannot be used with int* " + " in " +
+                            ast.name(procedure.name));
+      }
+      begin(e->operand(f.started++));
+      continue;
     }
 
-    type = "int";
+    TypeId type = typeFromOperands(
+        e, operandTypes.data() + operandTypes.size() - numOperands, procedure);
+    operandTypes.resize(operandTypes.size() - numOperands);
+    operandTypes.push_back(type);
+    e->type = type;
+    frames.pop_back();
   }
+  return operandTypes.back();
+}
 
-  else if (checkRule(root, {"factor", "ID", "LPAREN", "arglist", "RPAREN"},
-                     true)) {
-    string procName = root->children[0]->lexeme;
+// The type of expr, given the types of its operands.
+TypeId TypeChecker::typeFromOperands(Expr *expr, const TypeId *operands,
+                                     const ProcedureSymbols &procedure) {
+  TypeId type = TypeTable::NONE;
+
+  switch (expr->kind) {
+    /* Literals and identifiers */
+    case Expr::VAR:
+      expr->slot = findSymbol(procedure, expr->lexeme);
+      if (expr->slot != NO_SLOT) {
+        type = procedure.symbols[expr->slot].type;
+      }
+      break;
+    case Expr::NUM:
+      type = TypeTable::INT;
+      break;
+    case Expr::NULL_PTR:
+      type = TypeTable::INT_PTR;
+      break;
+
+    /* Pointers */
+    case Expr::ADDRESS_OF:
+      if (operands[0] != TypeTable::INT)
+        typeDerivationError("& must be used with int");
+      else
+        type = types.pointerTo(operands[0]);
+      break;
+
+    case Expr::DEREF:
+      if (!types.isPointer(operands[0])) {
+        typeDerivationError("cannot deference an int");
+      } else {
+        type = types.pointee(operands[0]);
+      }
+      break;
 
-    if (hasSymbol(procName, procedure)) {
-      variableOvershadowProcedureError(
-          "procedure " + procName +
-          " is overshadowed by variable with the same name, therefore cannot "
-          "be called.");
-    }
+    case Expr::NEW_ARRAY:
+      if (operands[0] != TypeTable::INT) {
+        typeDerivationError("new [] must use int parameter, instead " +
+                            types.name(operands[0]) + " is given");
+      }
 
-    vector<string> argTypeList;
-    getArgTypeList(root->children[2], procedure, argTypeList);
-    vector<string> functionSignature = getSignature(procName);
+      type = TypeTable::INT_PTR;
+      break;
+
+    case Expr::BINARY: {
+      TypeId l = operands[0];
+      TypeId r = operands[1];
+      switch (expr->op) {
+        /* Addition */
+        case BinaryOp::PLUS:
+          if (l == TypeTable::INT && r == TypeTable::INT) {
+            type = TypeTable::INT;
+          } else if (l == TypeTable::INT_PTR && r == TypeTable::INT) {
+            type = TypeTable::INT_PTR;
+          } else if (l == TypeTable::INT && r == TypeTable::INT_PTR) {
+            type = TypeTable::INT_PTR;
+          } else {  // (l == INT_PTR && r == INT_PTR) {
+            typeDerivationError("cannot add two int*");
+          }
+          break;
+
+        /* Subtraction */
+        case BinaryOp::MINUS:
+          if (l == TypeTable::INT && r == TypeTable::INT) {
+            type = TypeTable::INT;
+          } else if (l == TypeTable::INT_PTR && r == TypeTable::INT) {
+            type = TypeTable::INT_PTR;
+          } else if (l == TypeTable::INT && r == TypeTable::INT_PTR) {
+            typeDerivationError("cannot subtract int* from int");
+          } else {  // (l == INT_PTR && r == INT_PTR) {
+            type = TypeTable::INT;
+          }
+          break;
+
+        /* Multiplication and division and mod */
+        case BinaryOp::STAR:
+        case BinaryOp::SLASH:
+        case BinaryOp::PCT:
+          // typeOf has checked the left operand already
+          if (r != TypeTable::INT) {
+            typeDerivationError("invalid operation: " +
+                                string(opLexeme(expr->op)) +
+                                " cannot be used with int* " + " in " +
+                                ast.name(procedure.name));
+          }
+
+          type = TypeTable::INT;
+          break;
+
+        // Comparisons are tests, which have no type.
+        default:
+          break;
+      }
+      break;
+    }
+
+    /* Procedure call */
+    case Expr::CALL: {
+      // typeOf has checked the procedure is not shadowed
+      // A procedure never declared, which only an argument can call, is
+      // taken to have no parameters.
+      static const vector<TypeId> noParameters;
+      const ProcedureSymbols *callee = findProcedure(expr->lexeme);
+      const vector<TypeId> &functionSignature =
+          callee ? callee->signature : noParameters;
+
+      if (expr->args.empty()) {
+        if (functionSignature.size() != 0) {
+          typeDerivationError("procedure takes in 0 parameters");
+        }
+        type = TypeTable::INT;
+        break;
+      }
 
-    if (argTypeList.size() != functionSignature.size()) {
-      typeDerivationError("invalid number of arguments");
-    }
+      if (expr->args.size() != functionSignature.size()) {
+        typeDerivationError("invalid number of arguments");
+      }
 
-    for (int i = 0; i < argTypeList.size(); i++) {
-      if (argTypeList[i] != functionSignature[i]) {
-        typeDerivationError("procedure expected " + functionSignature[i] +
-                            ", got " + argTypeList[i]);
+      for (size_t i = 0; i < expr->args.size(); i++) {
+        if (operands[i] != functionSignature[i]) {
+          typeDerivationError("procedure expected " +
+                              types.name(functionSignature[i]) + ", got " +
+                              types.name(operands[i]));
+        }
       }
-    }
 
-    type = "int";
+      type = TypeTable::INT;
+      break;
+    }
   }
 
-  if (type == "") {
-    typeDerivationError("cannot be typed at " + getRule(root));
+  if (type == TypeTable::NONE) {
+    // Only an undeclared variable passed as an argument gets here: the symbol
+    // table pass does not look into argument lists.
+    typeDerivationError("cannot be typed at ");
   }
 
-  if (debug) {
-    cout << "Found type of " << root->val << " to be " << type << endl;
-  }
   return type;
 }
 
 void TypeChecker::typeCorrectnessError(string message) {
-  cerr << "ERROR: TypeCorrectnessError, " << message << endl;
-  throw TypeError();
+  throw TypeError("ERROR: TypeCorrectnessError, " + message);
 }
 void TypeChecker::typeDerivationError(string message) {
-  cerr << "ERROR: TypeDerivationError, " << message << endl;
-  throw TypeError();
+  throw TypeError("ERROR: TypeDerivationError, " + message);
 }
 void TypeChecker::redefinitionError(string message) {
-  cerr << "ERROR: RedefinitionError, " << message << endl;
-  throw TypeError();
+  throw TypeError("ERROR: RedefinitionError, " + message);
 }
 void TypeChecker::undeclaredError(string message) {
-  cerr << "ERROR: UndeclaredError, " << message << endl;
-  throw TypeError();
+  throw TypeError("ERROR: UndeclaredError, " + message);
 }
 void TypeChecker::unknownError(string message) {
-  cerr << "ERROR: UnknownError, " << message << endl;
-  throw TypeError();
+  throw TypeError("ERROR: UnknownError, " + message);
 }
 
 void TypeChecker::accessViolationError(string message) {
-  cerr << "ERROR: AccessViolationError, " << message << endl;
-  throw TypeError();
+  throw TypeError("ERROR: AccessViolationError, " + message);
 }
 
 void TypeChecker::variableOvershadowProcedureError(string message) {
-  cerr << "ERROR: variableOvershadowProcedureError, " << message << endl;
-  throw TypeError();
+  throw TypeError("ERROR: variableOvershadowProcedureError, " + message);
 }
 
 void TypeChecker::print() {
-  for (ProcedureTable::iterator it1 = symbolTable.begin();
-       it1 != symbolTable.end(); it1++) {
+  for (const ProcedureSymbols &procedure : procedures) {
     // Print the procedure name
-    cerr << it1->first << ": ";
+    cerr << ast.name(procedure.name) << ": ";
     // Print the procedure's signature
-    for (vector<string>::iterator vec = it1->second.first.begin();
-         vec != it1->second.first.end(); vec++) {
-      cerr << *vec << " ";
+    for (TypeId type : procedure.signature) {
+      cerr << types.name(type) << " ";
     }
     cerr << endl;
     // Print the procedure's symbol table
-    for (InnerSymbolTable::iterator it2 = it1->second.second.begin();
-         it2 != it1->second.second.end(); it2++) {
-      cerr << it2->first << " " << it2->second.first << endl;
+    for (const Symbol &symbol : procedure.symbols) {
+      cerr << ast.name(symbol.name) << " " << types.name(symbol.type) << endl;
     }
   }
-}
\ No newline at end of file
+}
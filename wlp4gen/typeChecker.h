@@ -1,6 +1,7 @@
 #ifndef TYPECHECKER_H
 #define TYPECHECKER_H
 
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -8,55 +9,97 @@
 #include <unordered_map>
 #include <vector>
 
+#include "ast.h"
+#include "threadPool.h"
+
 using namespace std;
 
-extern bool debug;
+// A symbol or type error, carrying the line to report: "ERROR: ...".
+class TypeError {
+ public:
+  explicit TypeError(string message) : message(message) {}
+  const string &what() const { return message; }
 
-struct TreeNode {
-  string val;
-  string lexeme;  // TreeNode should have either lexeme or children
-  vector<TreeNode *> children;
-  TreeNode() : val(0), children({}) {}
-  TreeNode(string value) : val(value), children({}) {}
-  TreeNode(string value, int length) : val(value), children(length, nullptr) {}
-  TreeNode(string value, string lexeme) : val(value), lexeme(lexeme) {}
+ private:
+  string message;
 };
 
-class TypeError {};
+// A parameter or local variable of a procedure.
+struct Symbol {
+  uint32_t name;  // lexeme id
+  TypeId type;
+  int offset;  // from $29, set by the code generator
+};
 
-// map<procedure_name, pair<vector<parameter_type>, map<variable_name,
-// pair<type, offset>>>>
-typedef unordered_map<string, pair<string, int>> InnerSymbolTable;
-typedef pair<vector<string>, InnerSymbolTable> SignatureInnerSymbolTable;
-typedef unordered_map<string, SignatureInnerSymbolTable> ProcedureTable;
+/*
+ * A procedure's signature and variables. The variables are a flat array,
+ * parameters first and then locals in the order they are declared, and a
+ * variable's index there is its slot: the checker resolves every VAR to its
+ * slot once, so the code generator reaches a variable without looking up
+ * its name.
+ */
+struct ProcedureSymbols {
+  uint32_t name;  // lexeme id
+  vector<TypeId> signature;
+  vector<Symbol> symbols;
+  unordered_map<uint32_t, uint32_t> slots;  // lexeme id to slot
+};
 
 class TypeChecker {
  public:
-  ProcedureTable symbolTable;
+  TypeTable types;
 
-  TypeChecker(TreeNode *root);
+  // Checks every procedure of ast: all of them are entered in the symbol
+  // table first, then each body is type checked in turn, or with a pool, at
+  // the same time on its threads.
+  TypeChecker(const Ast &ast, ThreadPool *pool = nullptr);
   virtual ~TypeChecker();
 
-  string typeOf(TreeNode *root, string procedure);
-  string getSymbolType(string name, string procedure);
-  int getSymbolOffset(string name, string procedure);
-  void setSymbolOffset(string name, string procedure, int offset);
-  const vector<string> &getSignature(string procedure);
+  // The two passes for one procedure, for a program checked as its
+  // procedures arrive. declare() is the symbol table pass; check() the type
+  // pass, which may only use procedures already declared: callsDeclared()
+  // says whether proc calls any that are not (yet), which only the
+  // arguments of a call can.
+  void declare(const Procedure *proc);
+  void check(const Procedure *proc);
+  bool callsDeclared(const Procedure *proc);
+
+  // The type of expr, worked out bottom up once: every expression typed is
+  // tagged with its type, and a tagged one is not looked into again. Each
+  // VAR is given its slot in procedure.
+  TypeId typeOf(Expr *expr, const ProcedureSymbols &procedure);
+  // The symbols of a declared procedure. They stay where they are as more
+  // procedures are declared.
+  ProcedureSymbols &symbolsOf(const Procedure *proc);
   void print();
 
- private:
-  bool hasProcedure(string procedure);
-  bool hasSymbol(string name, string procedure);
-
-  void getArgTypeList(TreeNode *root, string procedure,
-                      vector<string> &argTypeList);
-  string getRule(TreeNode *root);
+  static const uint32_t NO_SLOT = UINT32_MAX;
 
-  void buildSymbolTable(TreeNode *root);
-  void buildSigniture(TreeNode *root, SignatureInnerSymbolTable &SISTPair);
-  void buildInnerTable(TreeNode *root, SignatureInnerSymbolTable &SISTPair);
-  void validateWithType(TreeNode *root, string procedure);
-  void validateWithSymbolTable(TreeNode *root, string procedure);
+ private:
+  const Ast &ast;
+  deque<ProcedureSymbols> procedures;              // in the order declared
+  unordered_map<uint32_t, uint32_t> procedureIds;  // lexeme id to index
+
+  // The procedure called name, or nullptr if none has been declared.
+  const ProcedureSymbols *findProcedure(uint32_t name) const;
+  // The slot of the variable called name in procedure, or NO_SLOT.
+  static uint32_t findSymbol(const ProcedureSymbols &procedure,
+                             uint32_t name);
+
+  TypeId typeFromOperands(Expr *expr, const TypeId *operands,
+                          const ProcedureSymbols &procedure);
+
+  void buildSymbolTable();
+  void checkConcurrently(ThreadPool &pool);
+  void addSymbol(const Dcl *dcl, ProcedureSymbols &procedure);
+  void validateWithType(const Procedure *proc,
+                        const ProcedureSymbols &procedure);
+  void validateWithType(const NodeList<Stmt> &statements,
+                        const ProcedureSymbols &procedure);
+  void validateWithSymbolTable(const NodeList<Stmt> &statements,
+                               const ProcedureSymbols &procedure);
+  void validateWithSymbolTable(const Expr *expr,
+                               const ProcedureSymbols &procedure);
 
   /* Error */
   void typeCorrectnessError(string message);
@@ -70,7 +113,4 @@ class TypeChecker {
   void variableOvershadowProcedureError(string message);
 };
 
-/* Global Functions */
-bool checkRule(TreeNode *root, vector<string> rule, bool isStrict);
-
-#endif
\ No newline at end of file
+#endif
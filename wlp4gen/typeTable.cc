@@ -0,0 +1,12 @@
+#include "typeTable.h"
+
+TypeTable::TypeTable()
+    : types{{NONE, NONE, ""}, {NONE, INT_PTR, "int"}, {INT, NONE, "int*"}} {}
+
+TypeId TypeTable::pointerTo(TypeId type) {
+  if (types[type].pointer == NONE) {
+    types[type].pointer = TypeId(types.size());
+    types.push_back({type, NONE, types[type].name + "*"});
+  }
+  return types[type].pointer;
+}
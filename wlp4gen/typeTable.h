@@ -0,0 +1,46 @@
+#ifndef TYPETABLE_H
+#define TYPETABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A type, as its index in a TypeTable.
+typedef uint16_t TypeId;
+
+/*
+ * The types of a program, each interned once so that types are compared as
+ * integers. A table starts out with the types WLP4 has, at the same ids in
+ * every table, so code that only deals in those can use the constants below
+ * without a table at hand; pointerTo() adds deeper pointers as they are
+ * asked for.
+ */
+class TypeTable {
+ public:
+  static const TypeId NONE = 0;  // tests, and expressions not yet typed
+  static const TypeId INT = 1;
+  static const TypeId INT_PTR = 2;
+
+  TypeTable();
+
+  // The type of a pointer to type, which is added if it is new. The table
+  // is only written when one is, so pointers to types already there, like
+  // int*, can be asked for from several threads at once.
+  TypeId pointerTo(TypeId type);
+  // The type a pointer of type points to, or NONE if type is not a pointer.
+  TypeId pointee(TypeId type) const { return types[type].pointee; }
+  bool isPointer(TypeId type) const { return pointee(type) != NONE; }
+  // The type as it is written: "int", "int*", ...
+  const std::string &name(TypeId type) const { return types[type].name; }
+
+ private:
+  struct Entry {
+    TypeId pointee;
+    TypeId pointer;  // NONE until it is asked for
+    std::string name;
+  };
+
+  std::vector<Entry> types;
+};
+
+#endif
@@ -1,102 +1,233 @@
-#include "wlp4gen.h"
-
-#include <fstream>
-#include <iostream>
-#include <sstream>
-#include <stack>
-#include <unordered_map>
-#include <vector>
-
-#include "codeGenerator.h"
-#include "typeChecker.h"
-
-using namespace std;
-
-unordered_map<string, bool> WLP4gen::terminal{
-    {"BECOMES", true}, {"BOF", true},    {"COMMA", true},  {"ELSE", true},
-    {"EOF", true},     {"EQ", true},     {"GE", true},     {"GT", true},
-    {"ID", true},      {"IF", true},     {"INT", true},    {"LBRACE", true},
-    {"LE", true},      {"LPAREN", true}, {"LT", true},     {"MINUS", true},
-    {"NE", true},      {"NUM", true},    {"PCT", true},    {"PLUS", true},
-    {"PRINTLN", true}, {"RBRACE", true}, {"RETURN", true}, {"RPAREN", true},
-    {"SEMI", true},    {"SLASH", true},  {"STAR", true},   {"WAIN", true},
-    {"WHILE", true},   {"AMP", true},    {"LBRACK", true}, {"RBRACK", true},
-    {"NEW", true},     {"DELETE", true}, {"NULL", true}};
-
-WLP4gen::WLP4gen() { root = buildFromPreOrder(); }
-WLP4gen::~WLP4gen() {}
-
-void WLP4gen::printToPreOrder() { printToPreOrderHelper(root); }
-
-void WLP4gen::printToPreOrderHelper(TreeNode *node) {
-  if (!node) {
-    return;
-  }
-
-  if (terminal[node->val]) {
-    cout << node->val << " " << node->lexeme << endl;
-  } else {
-    cout << node->val << " ";
-    for (int i = 0; i < node->children.size(); i++) {
-      cout << node->children[i]->val << " ";
-    }
-    cout << endl;
-  }
-
-  for (int i = 0; i < node->children.size(); i++) {
-    printToPreOrderHelper(node->children[i]);
-  }
-}
-
-void WLP4gen::deleteTree() { deleteTreeHelper(root); }
-
-void WLP4gen::deleteTreeHelper(TreeNode *node) {
-  if (!node) {
-    return;
-  }
-
-  for (int i = 0; i < node->children.size(); i++) {
-    deleteTreeHelper(node->children[i]);
-  }
-
-  delete node;
-}
-
-TreeNode *WLP4gen::buildFromPreOrder() {
-  string name;
-  string token;
-  string line;
-  getline(cin, line);
-  stringstream ss(line);
-
-  ss >> name;
-  TreeNode *root = new TreeNode(name);
-
-  if (terminal[name]) {
-    ss >> token;
-    root->lexeme = token;
-  } else {
-    while (ss >> token) {
-      root->children.push_back(buildFromPreOrder());
-    };
-  }
-
-  return root;
-}
-
-int main() {
-  WLP4gen *wlp4g = new WLP4gen();
-
-  try {
-    TypeChecker *TC = new TypeChecker(wlp4g->root);
-    // TC->print();
-    CodeGenerator *CG = new CodeGenerator(wlp4g->root, TC);
-    delete TC;
-    delete CG;
-  } catch (TypeError se) {
-  }
-
-  wlp4g->deleteTree();
-
-  delete wlp4g;
-}
+#include "wlp4gen.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "ast.h"
+#include "codeGenerator.h"
+#include "sourceBuffer.h"
+#include "threadPool.h"
+#include "treeStream.h"
+#include "typeChecker.h"
+#include "wlp4Rules.h"
+
+using namespace std;
+
+const unordered_set<string_view> WLP4gen::terminals{
+    "BECOMES", "BOF",    "COMMA",  "ELSE",  "EOF",    "EQ",     "GE",
+    "GT",      "ID",     "IF",     "INT",   "LBRACE", "LE",     "LPAREN",
+    "LT",      "MINUS",  "NE",     "NUM",   "PCT",    "PLUS",   "PRINTLN",
+    "RBRACE",  "RETURN", "RPAREN", "SEMI",  "SLASH",  "STAR",   "WAIN",
+    "WHILE",   "AMP",    "LBRACK", "RBRACK", "NEW",   "DELETE", "NULL"};
+
+// The number of the rule whose text (see RULE_TEXT) is production, or
+// NO_RULE.
+static Rule ruleOf(string_view production) {
+  static const unordered_map<string_view, Rule> rules = []() {
+    unordered_map<string_view, Rule> rules;
+    for (int r = 0; r < NUM_RULES; r++) {
+      rules[RULE_TEXT[r]] = Rule(r);
+    }
+    return rules;
+  }();
+  auto it = rules.find(production);
+  return it == rules.end() ? NO_RULE : it->second;
+}
+
+// The rules of RULE_TEXT split into their symbols, and the terminals, for
+// checking binary trees against.
+static const TreeGrammar &treeGrammar() {
+  static const TreeGrammar grammar = []() {
+    TreeGrammar grammar;
+    for (int r = 0; r < NUM_RULES; r++) {
+      string_view text = RULE_TEXT[r];
+      grammar.rules.emplace_back();
+      for (size_t begin = 0; begin < text.size();) {
+        size_t end = min(text.find(' ', begin), text.size());
+        grammar.rules.back().push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+      }
+    }
+    grammar.terminals.assign(WLP4gen::terminals.begin(),
+                             WLP4gen::terminals.end());
+    return grammar;
+  }();
+  return grammar;
+}
+
+WLP4gen::WLP4gen(string_view input) : input(input), posn(0) {
+  // Empty input, from a failed parse, leaves the tree empty.
+  if (TreeStreamReader::isTreeStream(input)) {
+    TreeStreamReader reader(input);
+    if (reader.grammarChecksum() != RULES_GRAMMAR_CHECKSUM) {
+      throw runtime_error(
+          "the parse tree was built with a different grammar");
+    }
+    tree.root = reader.read(tree, treeGrammar());
+  } else if (!input.empty()) {
+    tree.root = buildFromPreOrder();
+  }
+}
+WLP4gen::~WLP4gen() {}
+
+void WLP4gen::printToPreOrder() { printToPreOrderHelper(tree.root); }
+
+// Trees are walked with explicit stacks: statements are left-recursive, so a
+// tree is as deep as its longest statement list.
+
+void WLP4gen::printToPreOrderHelper(TreeNode *root) {
+  vector<const TreeNode *> stack{root};
+  while (!stack.empty()) {
+    const TreeNode *node = stack.back();
+    stack.pop_back();
+    if (!node) {
+      continue;
+    }
+
+    if (terminals.count(tree.kindName(node))) {
+      cout << tree.kindName(node) << " " << tree.lexeme(node) << '\n';
+    } else {
+      cout << tree.kindName(node) << " ";
+      for (size_t i = 0; i < node->children().size(); i++) {
+        cout << tree.kindName(node->children()[i]) << " ";
+      }
+      cout << '\n';
+    }
+
+    for (size_t i = node->children().size(); i-- > 0;) {
+      stack.push_back(node->children()[i]);
+    }
+  }
+}
+
+TreeNode *WLP4gen::buildFromPreOrder() {
+  // Nodes whose children are still being read, with how many have been.
+  vector<pair<TreeNode *, uint32_t>> open;
+  TreeNode *root = nullptr;
+  do {
+    TreeNode *node = readNode();
+    if (open.empty()) {
+      root = node;
+    } else {
+      open.back().first->children()[open.back().second++] = node;
+    }
+    if (!node->children().empty()) {
+      open.emplace_back(node, 0);
+    }
+    while (!open.empty() &&
+           open.back().second == open.back().first->children().size()) {
+      open.pop_back();
+    }
+  } while (!open.empty());
+
+  return root;
+}
+
+// The next line of input without its newline; past the end, empty lines.
+string_view WLP4gen::nextLine() {
+  size_t end = input.find('\n', posn);
+  if (end == string_view::npos) {
+    end = input.size();
+  }
+  string_view line = input.substr(posn, end - posn);
+  posn = min(end + 1, input.size());
+  return line;
+}
+
+// Splits off the first space separated word of line.
+static string_view nextWord(string_view &line) {
+  size_t begin = line.find_first_not_of(" \t\r");
+  if (begin == string_view::npos) {
+    line = string_view();
+    return line;
+  }
+  size_t end = min(line.find_first_of(" \t\r", begin), line.size());
+  string_view word = line.substr(begin, end - begin);
+  line.remove_prefix(end);
+  return word;
+}
+
+// One line of the tree: a leaf, or a node with its children left to fill in.
+TreeNode *WLP4gen::readNode() {
+  string_view line = nextLine();
+  string_view name = nextWord(line);
+  uint32_t kind = tree.internKind(name);
+
+  if (terminals.count(name)) {
+    return tree.makeLeaf(kind, nextWord(line));
+  }
+
+  // The whole line is the production the node was reduced by; the rest of
+  // it names the children, so it also counts them.
+  string production(name);
+  size_t numChildren = 0;
+  for (string_view child = nextWord(line); !child.empty();
+       child = nextWord(line)) {
+    production += ' ';
+    production += child;
+    numChildren++;
+  }
+  return tree.makeNode(kind, ruleOf(production), numChildren);
+}
+
+/*
+ * Reads the parse tree wlp4parse wrote and prints the MIPS assembly for the
+ * program. With --threads N the procedures are type checked, and then
+ * compiled, on N threads; the output, and the error reported, are the same.
+ */
+int main(int argc, char *argv[]) {
+  size_t numThreads = 1;
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "--threads" && i + 1 < argc) {
+      numThreads = strtoul(argv[++i], nullptr, 10);
+    } else {
+      cerr << "Usage: " << argv[0] << " [--threads N] < program.tree" << endl;
+      return 1;
+    }
+  }
+
+  SourceBuffer input(STDIN_FILENO);
+  WLP4gen *wlp4g;
+  try {
+    wlp4g = new WLP4gen(input.view());
+  } catch (runtime_error &e) {
+    cerr << "ERROR: " << e.what() << endl;
+    return 1;
+  }
+
+  try {
+    Ast ast(wlp4g->tree);
+    // Only the lexemes are needed from here on.
+    wlp4g->tree.release();
+
+    unique_ptr<ThreadPool> pool;
+    if (numThreads > 1) {
+      pool = make_unique<ThreadPool>(numThreads);
+    }
+    TypeChecker *TC = new TypeChecker(ast, pool.get());
+    // TC->print();
+    CodeGenerator *CG = new CodeGenerator(ast, TC, cout, pool.get());
+    delete TC;
+    delete CG;
+  } catch (TypeError &e) {
+    cerr << e.what() << endl;
+  } catch (runtime_error &e) {
+    // A tree the lowering rejects is as malformed as one the reader does.
+    cerr << "ERROR: " << e.what() << endl;
+    delete wlp4g;
+    return 1;
+  }
+
+  delete wlp4g;
+}
@@ -1,30 +1,37 @@
-#ifndef WLP4GEN_H
-#define WLP4GEN_H
-
-#include <fstream>
-#include <iostream>
-#include <sstream>
-#include <stack>
-#include <unordered_map>
-#include <vector>
-
-#include "typeChecker.h"
-
-class WLP4gen {
- public:
-  static unordered_map<string, bool> terminal;
-  TreeNode *root;
-
-  WLP4gen();
-  virtual ~WLP4gen();
-
-  void printToPreOrder();
-  void deleteTree();
-
- private:
-  void printToPreOrderHelper(TreeNode *root);
-  void deleteTreeHelper(TreeNode *root);
-  TreeNode *buildFromPreOrder();
-};
-
-#endif
+#ifndef WLP4GEN_H
+#define WLP4GEN_H
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stack>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "parseTree.h"
+#include "typeChecker.h"
+
+class WLP4gen {
+ public:
+  static const std::unordered_set<std::string_view> terminals;
+  ParseTree tree;
+
+  // Reads the tree wlp4parse wrote, as preorder text or in the binary
+  // format of treeStream.h.
+  explicit WLP4gen(std::string_view input);
+  virtual ~WLP4gen();
+
+  void printToPreOrder();
+
+ private:
+  void printToPreOrderHelper(TreeNode *root);
+  TreeNode *buildFromPreOrder();
+  TreeNode *readNode();
+  std::string_view nextLine();
+
+  std::string_view input;
+  size_t posn;  // of the next line of input
+};
+
+#endif
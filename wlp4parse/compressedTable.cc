@@ -0,0 +1,90 @@
+#include "compressedTable.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+CompressedTable::CompressedTable(const Grammar &grammar)
+    : columns(grammar.numSymbols() + 1) {
+  int numStates = grammar.numStates();
+  defaultAction.assign(numStates, Grammar::packAction(Grammar::ERROR, 0));
+  base.assign(numStates, 0);
+  errorBits.assign((size_t(numStates) * columns + 63) / 64, 0);
+
+  // The cells of each row that have to be stored explicitly.
+  std::vector<std::vector<std::pair<int, uint32_t>>> rows(numStates);
+  for (int state = 0; state < numStates; state++) {
+    std::map<uint32_t, int> reduceCounts;
+    for (int sym = 0; sym < columns; sym++) {
+      uint32_t entry = grammar.lookupAction(state, sym);
+      if (Grammar::actionKind(entry) == Grammar::REDUCE) {
+        reduceCounts[entry]++;
+      }
+    }
+    int mostCommon = 0;
+    for (auto &count : reduceCounts) {
+      if (count.second > mostCommon) {
+        mostCommon = count.second;
+        defaultAction[state] = count.first;
+      }
+    }
+
+    for (int sym = 0; sym < columns; sym++) {
+      uint32_t entry = grammar.lookupAction(state, sym);
+      size_t cell = size_t(state) * columns + sym;
+      if (Grammar::actionKind(entry) == Grammar::ERROR) {
+        errorBits[cell / 64] |= uint64_t(1) << (cell % 64);
+      } else if (entry != defaultAction[state]) {
+        rows[state].push_back({sym, entry});
+      }
+    }
+  }
+
+  // Place the densest rows first; each goes at the lowest offset where all
+  // of its cells land on free slots.
+  std::vector<int> order(numStates);
+  for (int state = 0; state < numStates; state++) {
+    order[state] = state;
+  }
+  std::stable_sort(order.begin(), order.end(), [&rows](int a, int b) {
+    return rows[a].size() > rows[b].size();
+  });
+
+  for (int state : order) {
+    if (rows[state].empty()) {
+      continue;  // base 0; check never matches, so lookups fall through
+    }
+    size_t offset = 0;
+    while (true) {
+      bool fits = true;
+      for (auto &cell : rows[state]) {
+        size_t slot = offset + cell.first;
+        if (slot < check.size() && check[slot] != -1) {
+          fits = false;
+          break;
+        }
+      }
+      if (fits) {
+        break;
+      }
+      offset++;
+    }
+
+    base[state] = offset;
+    size_t end = offset + rows[state].back().first + 1;
+    if (end > check.size()) {
+      check.resize(end, -1);
+      packed.resize(end, Grammar::packAction(Grammar::ERROR, 0));
+    }
+    for (auto &cell : rows[state]) {
+      check[offset + cell.first] = state;
+      packed[offset + cell.first] = cell.second;
+    }
+  }
+}
+
+size_t CompressedTable::bytes() const {
+  return defaultAction.size() * sizeof(uint32_t) +
+         base.size() * sizeof(uint32_t) + packed.size() * sizeof(uint32_t) +
+         check.size() * sizeof(int32_t) + errorBits.size() * sizeof(uint64_t);
+}
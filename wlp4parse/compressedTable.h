@@ -0,0 +1,54 @@
+#ifndef COMPRESSEDTABLE_H
+#define COMPRESSEDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "grammar.h"
+
+/*
+ * A compressed copy of a grammar's action table, for grammars whose dense
+ * [state][symbol] table no longer fits in cache. lookupAction returns
+ * exactly the entry the dense table holds, so buildFromLR can run on either.
+ *
+ * Three encodings are combined:
+ *  - Default reductions: the reduce action that fills the most cells of a
+ *    state's row becomes that row's default and is not stored per cell.
+ *  - Row displacement: the remaining entries of every row (shifts, gotos and
+ *    other reductions) are overlaid into one comb vector, each row at its
+ *    own offset so that no two rows use the same slot. A parallel check
+ *    vector records which state owns each slot.
+ *  - An error bitset with one bit per cell, so that error entries are still
+ *    detected exactly where the dense table has them instead of being
+ *    swallowed by a default reduction.
+ */
+class CompressedTable {
+ public:
+  explicit CompressedTable(const Grammar &grammar);
+
+  uint32_t lookupAction(int state, int symbol) const {
+    size_t cell = size_t(state) * columns + symbol;
+    if (errorBits[cell / 64] >> (cell % 64) & 1) {
+      return Grammar::packAction(Grammar::ERROR, 0);
+    }
+    size_t slot = size_t(base[state]) + symbol;
+    if (slot < check.size() && check[slot] == state) {
+      return packed[slot];
+    }
+    return defaultAction[state];
+  }
+
+  // Bytes used by the encoded table.
+  size_t bytes() const;
+
+ private:
+  int columns;
+  std::vector<uint32_t> defaultAction;  // per state
+  std::vector<uint32_t> base;           // per state offset into packed
+  std::vector<uint32_t> packed;
+  std::vector<int32_t> check;           // state owning each slot, or -1
+  std::vector<uint64_t> errorBits;
+};
+
+#endif
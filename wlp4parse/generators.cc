@@ -0,0 +1,220 @@
+#include "generators.h"
+
+#include <iomanip>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The symbol name as a trailing comment.
+std::string nameComment(const Grammar &grammar, int symbol) {
+  return "  // " + std::string(grammar.symbolName(symbol));
+}
+
+std::string ruleText(const Grammar &grammar, int r) {
+  std::string text(grammar.symbolName(grammar.ruleLhs(r)));
+  for (int i = 0; i < grammar.ruleLength(r); i++) {
+    text += " ";
+    text += grammar.symbolName(grammar.ruleRhs(r, i));
+  }
+  return text;
+}
+
+bool onlyRuleForLhs(const Grammar &grammar, int r) {
+  for (int other = 0; other < grammar.numRules(); other++) {
+    if (other != r && grammar.ruleLhs(other) == grammar.ruleLhs(r)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The enumerator of rule r: R_ followed by its symbols, joined with _, or
+// just by its left hand side if that is the only rule for it.
+std::string ruleName(const Grammar &grammar, int r) {
+  std::string name = "R_" + std::string(grammar.symbolName(grammar.ruleLhs(r)));
+  if (onlyRuleForLhs(grammar, r)) {
+    return name;
+  }
+  for (int i = 0; i < grammar.ruleLength(r); i++) {
+    name += "_";
+    name += grammar.symbolName(grammar.ruleRhs(r, i));
+  }
+  return grammar.ruleLength(r) == 0 ? name + "_EMPTY" : name;
+}
+
+}  // namespace
+
+void emitTables(const Grammar &grammar, std::ostream &out) {
+  std::string_view image = grammar.image();
+  out << "// Generated by wlp4parse --emit-tables from WLP4.lr1. Do not edit.\n"
+      << "#ifndef WLP4TABLES_H\n"
+      << "#define WLP4TABLES_H\n\n"
+      << "// The WLP4 grammar as an image in the format described in "
+         "grammar.h.\n"
+      << "alignas(4) constexpr unsigned char WLP4_GRAMMAR_IMAGE["
+      << image.size() << "] = {";
+  for (size_t i = 0; i < image.size(); i++) {
+    out << (i % 12 == 0 ? "\n   " : "") << " 0x" << std::hex << std::setw(2)
+        << std::setfill('0') << int(static_cast<unsigned char>(image[i]))
+        << ",";
+  }
+  out << std::dec << "\n};\n\n#endif\n";
+}
+
+void emitDirectParser(const Grammar &grammar, std::ostream &out) {
+  // Rules the table ever reduces by, and the non-terminals that need a goto
+  // function because of them. Rule 0 also needs a reduce function for the
+  // final reduction.
+  std::set<int> reducedRules = {0};
+  std::set<int> gotoSymbols;
+  for (int state = 0; state < grammar.numStates(); state++) {
+    for (int sym = 0; sym < grammar.numSymbols(); sym++) {
+      uint32_t entry = grammar.lookupAction(state, sym);
+      if (Grammar::actionKind(entry) == Grammar::REDUCE) {
+        reducedRules.insert(Grammar::actionTarget(entry));
+        gotoSymbols.insert(grammar.ruleLhs(Grammar::actionTarget(entry)));
+      }
+    }
+  }
+
+  out << "// Generated by wlp4parse --emit-direct from WLP4.lr1. Do not edit.\n"
+      << "#include \"wlp4Direct.h\"\n\n"
+      << "const uint32_t DIRECT_GRAMMAR_CHECKSUM = 0x" << std::hex
+      << grammar.imageChecksum() << std::dec << ";\n\n"
+      << "namespace {\n\n"
+      << "typedef std::vector<int> StateStack;\n"
+      << "typedef std::vector<TreeNode *> TreeStack;\n";
+
+  // One reduce function per rule, building a node of that rule's shape. A
+  // rule with no right-hand side pops nothing, so its stacks are unnamed.
+  for (int r : reducedRules) {
+    int lhs = grammar.ruleLhs(r);
+    int length = grammar.ruleLength(r);
+    out << "\n// " << ruleText(grammar, r) << "\n"
+        << "TreeNode *reduce" << r
+        << (length > 0
+                ? "(ParseTree &tree, StateStack &states, TreeStack &trees) {\n"
+                : "(ParseTree &tree, StateStack &, TreeStack &) {\n");
+    if (length > 0) {
+      out << "  TreeNode *node = tree.makeNode(" << lhs << ", " << r
+          << ", trees.data() + trees.size() - " << length << ", " << length
+          << ");\n"
+          << "  trees.resize(trees.size() - " << length << ");\n"
+          << "  states.resize(states.size() - " << length << ");\n";
+    } else {
+      out << "  TreeNode *node = tree.makeNode(" << lhs << ", " << r
+          << ", 0);\n";
+    }
+    out << "  return node;\n"
+        << "}\n";
+  }
+
+  /*
+   * The parser itself is one function with a label per state. Shifts know
+   * their next state, so they jump straight to it. After a reduction the
+   * next state depends on the state uncovered on the stack, so each
+   * non-terminal has a goto block that switches on it; a missing goto
+   * entry means state 0, as in the table.
+   */
+  out << "\n}  // namespace\n\n"
+      << "TreeNode *parseDirect(ParseTree &tree, std::vector<TreeNode *> "
+         "&sequence,\n"
+      << "                      std::ostream &err) {\n"
+      << "  StateStack states;\n"
+      << "  TreeStack trees;\n"
+      << "  states.reserve(sequence.size() + 1);\n"
+      << "  trees.reserve(sequence.size());\n"
+      << "  size_t i = 0;\n"
+      << "  int sym;\n\n"
+      << "  states.push_back(0);\n"
+      << "  goto state0;\n";
+
+  for (int state = 0; state < grammar.numStates(); state++) {
+    // Group the lookaheads that share an action.
+    std::map<uint32_t, std::vector<int>> byAction;
+    for (int sym = 0; sym < grammar.numSymbols(); sym++) {
+      uint32_t entry = grammar.lookupAction(state, sym);
+      if (Grammar::actionKind(entry) != Grammar::ERROR) {
+        byAction[entry].push_back(sym);
+      }
+    }
+
+    out << "\nstate" << state << ":\n"
+        << "  if (i == sequence.size()) goto accept;\n"
+        << "  sym = sequence[i]->kind;\n"
+        << "  switch (sym) {\n";
+    for (auto &action : byAction) {
+      for (int sym : action.second) {
+        out << "    case " << sym << ":" << nameComment(grammar, sym) << "\n";
+      }
+      int target = Grammar::actionTarget(action.first);
+      if (Grammar::actionKind(action.first) == Grammar::SHIFT) {
+        out << "      trees.push_back(sequence[i++]);\n"
+            << "      states.push_back(" << target << ");\n"
+            << "      goto state" << target << ";\n";
+      } else {
+        out << "      trees.push_back(reduce" << target
+            << "(tree, states, trees));\n"
+            << "      goto goto" << grammar.ruleLhs(target) << ";\n";
+      }
+    }
+    out << "  }\n"
+        << "  goto reject;\n";
+  }
+
+  for (int lhs : gotoSymbols) {
+    out << "\ngoto" << lhs << ":" << nameComment(grammar, lhs) << "\n"
+        << "  switch (states.back()) {\n";
+    for (int state = 0; state < grammar.numStates(); state++) {
+      uint32_t entry = grammar.lookupAction(state, lhs);
+      if (Grammar::actionKind(entry) == Grammar::SHIFT) {
+        int target = Grammar::actionTarget(entry);
+        out << "    case " << state << ": states.push_back(" << target
+            << "); goto state" << target << ";\n";
+      }
+    }
+    out << "  }\n"
+        << "  states.push_back(0);\n"
+        << "  goto state0;\n";
+  }
+
+  out << "\nreject:\n"
+      << "  rejectParse(i, err);\n"
+      << "  return nullptr;\n\n"
+      << "accept:\n"
+      << "  return reduce0(tree, states, trees);\n"
+      << "}\n";
+}
+
+void emitRules(const Grammar &grammar, std::ostream &out) {
+  out << "// Generated by wlp4parse --emit-rules from WLP4.lr1. Do not edit.\n"
+      << "#ifndef WLP4RULES_H\n"
+      << "#define WLP4RULES_H\n\n"
+      << "#include <cstdint>\n\n"
+      << "// Grammar::imageChecksum() of the grammar these rules come from.\n"
+      << "constexpr uint32_t RULES_GRAMMAR_CHECKSUM = 0x" << std::hex
+      << grammar.imageChecksum() << std::dec << ";\n\n"
+      << "// The production rules of WLP4.lr1, numbered as in the file. A\n"
+      << "// parse tree node reduced by a rule records it in TreeNode::rule.\n"
+      << "enum Rule : int32_t {\n"
+      << "  NO_RULE = -1,  // leaves, and nodes that match no rule\n";
+  for (int r = 0; r < grammar.numRules(); r++) {
+    out << "  " << ruleName(grammar, r) << " = " << r << ",";
+    if (onlyRuleForLhs(grammar, r)) {
+      out << "  // " << ruleText(grammar, r);
+    }
+    out << "\n";
+  }
+  out << "  NUM_RULES = " << grammar.numRules() << "\n"
+      << "};\n\n"
+      << "// Each rule as \"lhs rhs...\", the form of an interior node's line\n"
+      << "// in the preorder tree format.\n"
+      << "constexpr const char *RULE_TEXT[NUM_RULES] = {\n";
+  for (int r = 0; r < grammar.numRules(); r++) {
+    out << "    \"" << ruleText(grammar, r) << "\",\n";
+  }
+  out << "};\n\n#endif\n";
+}
@@ -0,0 +1,28 @@
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include <ostream>
+
+#include "grammar.h"
+
+/*
+ * Code generators that compile a grammar into C++ source files that are
+ * checked in next to the parser. Both are run through wlp4parse itself:
+ *
+ *   wlp4parse --grammar wlp4parse/WLP4.lr1 --emit-tables > wlp4parse/wlp4Tables.h
+ *   wlp4parse --grammar wlp4parse/WLP4.lr1 --emit-direct > wlp4parse/wlp4Direct.cc
+ *   wlp4parse --grammar wlp4parse/WLP4.lr1 --emit-rules > common/wlp4Rules.h
+ */
+
+// Writes the grammar's image as a constexpr byte array (wlp4Tables.h).
+void emitTables(const Grammar &grammar, std::ostream &out);
+
+// Writes a direct-coded LR parser for the grammar (wlp4Direct.cc); see
+// wlp4Direct.h.
+void emitDirectParser(const Grammar &grammar, std::ostream &out);
+
+// Writes an enum of the grammar's production rules and their text
+// (wlp4Rules.h), for the stages after the parser to dispatch on.
+void emitRules(const Grammar &grammar, std::ostream &out);
+
+#endif
@@ -0,0 +1,279 @@
+#include "grammar.h"
+#include "wlp4Tables.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const char MAGIC[8] = {'W', 'L', 'P', '4', 'L', 'R', '1', '\0'};
+const size_t HEADER_WORDS = 7;  // the u32 fields from numTerminals on
+const size_t HEADER_BYTES = sizeof(MAGIC) + 8 + HEADER_WORDS * 4;
+
+uint32_t checksum(std::string_view bytes) {
+  uint32_t hash = 2166136261u;
+  for (unsigned char c : bytes) {
+    hash = (hash ^ c) * 16777619u;
+  }
+  return hash;
+}
+
+void appendWord(std::string &out, uint32_t w) {
+  out.append(reinterpret_cast<const char *>(&w), sizeof(w));
+}
+
+uint32_t readWord(std::string_view data, size_t offset) {
+  uint32_t w;
+  memcpy(&w, data.data() + offset, sizeof(w));
+  return w;
+}
+
+}  // namespace
+
+bool Grammar::isImage(std::string_view data) {
+  return data.size() >= sizeof(MAGIC) &&
+         memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+Grammar::Grammar()
+    : numTerminals(0),
+      numNonTerminals(0),
+      startSymbol(0),
+      rules(0),
+      states(0),
+      nameEnd(nullptr),
+      lhs(nullptr),
+      rhsEnd(nullptr),
+      rhs(nullptr),
+      action(nullptr),
+      names(nullptr) {}
+
+void Grammar::load(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open grammar file " + path);
+  }
+  file.reset(new SourceBuffer(fd));
+  close(fd);  // a mapping outlives its descriptor
+
+  if (isImage(file->view())) {
+    useImage(file->view());
+  } else {
+    loadText(file->view());
+    file.reset();
+  }
+}
+
+void Grammar::loadEmbedded() {
+  file.reset();
+  useImage(std::string_view(reinterpret_cast<const char *>(WLP4_GRAMMAR_IMAGE),
+                            sizeof(WLP4_GRAMMAR_IMAGE)));
+}
+
+void Grammar::loadText(std::string_view text) {
+  std::istringstream in{std::string(text)};
+  std::string line, word;
+  std::vector<std::string> symbols;
+  std::unordered_map<std::string, uint32_t> ids;
+
+  auto readCount = [&]() {
+    long n = -1;
+    if (!std::getline(in, line) || !(std::istringstream(line) >> n) ||
+        n < 0) {
+      throw std::runtime_error("malformed grammar file: expected a count");
+    }
+    return uint32_t(n);
+  };
+  auto readSymbol = [&]() {
+    if (!std::getline(in, line) || !(std::istringstream(line) >> word)) {
+      throw std::runtime_error("malformed grammar file: expected a symbol");
+    }
+    return word;
+  };
+  auto idOf = [&](const std::string &name) {
+    auto it = ids.find(name);
+    if (it == ids.end()) {
+      throw std::runtime_error("malformed grammar file: unknown symbol " +
+                               name);
+    }
+    return it->second;
+  };
+
+  // terminals, then non-terminals, one per line
+  uint32_t terminals = readCount();
+  for (uint32_t i = 0; i < terminals; i++) {
+    ids[readSymbol()] = symbols.size();
+    symbols.push_back(word);
+  }
+  uint32_t nonTerminals = readCount();
+  for (uint32_t i = 0; i < nonTerminals; i++) {
+    ids[readSymbol()] = symbols.size();
+    symbols.push_back(word);
+  }
+  uint32_t start = idOf(readSymbol());
+
+  // production rules, "lhs rhs..." one per line
+  uint32_t numRule = readCount();
+  std::vector<uint32_t> ruleLhs, ruleRhsEnd, ruleRhs;
+  for (uint32_t i = 0; i < numRule; i++) {
+    if (!std::getline(in, line)) {
+      throw std::runtime_error("malformed grammar file: missing rules");
+    }
+    std::istringstream ss(line);
+    if (!(ss >> word)) {
+      throw std::runtime_error("malformed grammar file: empty rule");
+    }
+    ruleLhs.push_back(idOf(word));
+    while (ss >> word) {
+      ruleRhs.push_back(idOf(word));
+    }
+    ruleRhsEnd.push_back(ruleRhs.size());
+  }
+
+  // "state symbol shift state" and "state symbol reduce rule" actions
+  uint32_t numState = readCount();
+  uint32_t numAction = readCount();
+  size_t columns = symbols.size() + 1;
+  std::vector<uint32_t> table(size_t(numState) * columns, packAction(ERROR, 0));
+  for (uint32_t i = 0; i < numAction; i++) {
+    long state, target;
+    std::string symbol, kind;
+    // A shift goes to a state and a reduce is by a rule, and either must
+    // fit in the target field of a packed action.
+    if (!(in >> state >> symbol >> kind >> target) || state < 0 ||
+        state >= long(numState) || target < 0 ||
+        (kind != "shift" && kind != "reduce") ||
+        target >= long(kind == "shift" ? numState : numRule) ||
+        target > long(ACTION_TARGET_MASK)) {
+      throw std::runtime_error("malformed grammar file: bad action " +
+                               std::to_string(i));
+    }
+    table[state * columns + idOf(symbol)] =
+        packAction(kind == "reduce" ? REDUCE : SHIFT, target);
+  }
+
+  std::string nameBlob;
+  std::vector<uint32_t> nameEnds;
+  for (auto &symbol : symbols) {
+    nameBlob += symbol;
+    nameEnds.push_back(nameBlob.size());
+  }
+
+  std::string image(MAGIC, sizeof(MAGIC));
+  appendWord(image, VERSION);
+  appendWord(image, 0);  // checksum, filled in below
+  for (uint32_t w : {terminals, nonTerminals, start, numRule, numState,
+                     uint32_t(ruleRhs.size()), uint32_t(nameBlob.size())}) {
+    appendWord(image, w);
+  }
+  for (auto *section : {&nameEnds, &ruleLhs, &ruleRhsEnd, &ruleRhs, &table}) {
+    for (uint32_t w : *section) {
+      appendWord(image, w);
+    }
+  }
+  image += nameBlob;
+  image.resize((image.size() + 3) & ~size_t(3), '\0');
+
+  uint32_t sum = checksum(std::string_view(image).substr(sizeof(MAGIC) + 8));
+  memcpy(&image[sizeof(MAGIC) + 4], &sum, sizeof(sum));
+
+  built = std::move(image);
+  useImage(built);
+}
+
+void Grammar::useImage(std::string_view image) {
+  if (image.size() < HEADER_BYTES || !isImage(image)) {
+    throw std::runtime_error("not a grammar image");
+  }
+  if (readWord(image, 8) != VERSION) {
+    throw std::runtime_error("unsupported grammar image version " +
+                             std::to_string(readWord(image, 8)));
+  }
+  if (readWord(image, 12) != checksum(image.substr(sizeof(MAGIC) + 8))) {
+    throw std::runtime_error("grammar image checksum mismatch");
+  }
+  if (reinterpret_cast<uintptr_t>(image.data()) % sizeof(uint32_t)) {
+    throw std::runtime_error("misaligned grammar image");
+  }
+
+  numTerminals = readWord(image, 16);
+  numNonTerminals = readWord(image, 20);
+  startSymbol = readWord(image, 24);
+  rules = readWord(image, 28);
+  states = readWord(image, 32);
+  uint32_t rhsSize = readWord(image, 36);
+  uint32_t nameBytes = readWord(image, 40);
+
+  // Sizes are summed in 64 bits, so no count can wrap the total.
+  uint64_t symbols = uint64_t(numTerminals) + numNonTerminals;
+  uint64_t words = symbols + 2 * uint64_t(rules) + rhsSize +
+                   uint64_t(states) * (symbols + 1);
+  uint64_t expected = HEADER_BYTES + words * 4 + ((nameBytes + 3ull) & ~3ull);
+  if (expected != image.size() || symbols == 0 || rules == 0 || states == 0) {
+    throw std::runtime_error("truncated or oversized grammar image");
+  }
+
+  const uint32_t *w =
+      reinterpret_cast<const uint32_t *>(image.data() + HEADER_BYTES);
+  nameEnd = w;
+  lhs = nameEnd + symbols;
+  rhsEnd = lhs + rules;
+  rhs = rhsEnd + rules;
+  action = rhs + rhsSize;
+  names = reinterpret_cast<const char *>(action + states * (symbols + 1));
+  data = image;
+
+  // Validate every index once so the parser can trust them.
+  for (uint32_t i = 0; i < symbols; i++) {
+    if (nameEnd[i] > nameBytes || (i > 0 && nameEnd[i] < nameEnd[i - 1])) {
+      throw std::runtime_error("corrupt grammar image symbol table");
+    }
+  }
+  if (startSymbol >= symbols) {
+    throw std::runtime_error("corrupt grammar image start symbol");
+  }
+  for (uint32_t r = 0; r < rules; r++) {
+    if (!isNonTerminal(lhs[r]) || rhsEnd[r] > rhsSize ||
+        (r > 0 && rhsEnd[r] < rhsEnd[r - 1])) {
+      throw std::runtime_error("corrupt grammar image rule table");
+    }
+  }
+  for (uint32_t i = 0; i < rhsSize; i++) {
+    if (rhs[i] >= symbols) {
+      throw std::runtime_error("corrupt grammar image rule table");
+    }
+  }
+  for (uint64_t i = 0; i < states * (symbols + 1); i++) {
+    ActionKind kind = actionKind(action[i]);
+    uint32_t target = actionTarget(action[i]);
+    if ((kind == SHIFT && target >= states) ||
+        (kind == REDUCE && target >= rules) || kind > REDUCE) {
+      throw std::runtime_error("corrupt grammar image action table");
+    }
+  }
+
+  symbolId.clear();
+  for (int i = 0; i < numSymbols(); i++) {
+    symbolId[symbolName(i)] = i;
+  }
+}
+
+uint32_t Grammar::imageChecksum() const { return readWord(data, 12); }
+
+int Grammar::lookupSymbol(std::string_view name) const {
+  auto it = symbolId.find(name);
+  return it == symbolId.end() ? unknownSymbol() : it->second;
+}
+
+std::string_view Grammar::symbolName(int symbol) const {
+  if (symbol < 0 || symbol >= numSymbols()) {
+    return "";
+  }
+  uint32_t begin = symbol == 0 ? 0 : nameEnd[symbol - 1];
+  return std::string_view(names + begin, nameEnd[symbol] - begin);
+}
@@ -0,0 +1,126 @@
+#ifndef GRAMMAR_H
+#define GRAMMAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "sourceBuffer.h"
+
+/*
+ * The LR(1) automaton the WLP4 parser runs on, loaded either from the text
+ * format of WLP4.lr1 or from a precompiled binary image of it.
+ *
+ * Whatever the source, the loaded grammar lives in the image format, and
+ * every accessor reads straight out of it. A grammar loaded from an image
+ * file therefore needs no parsing at all: the file is mapped, its checksum
+ * and indices are validated once, and the action table is used in place.
+ * Text grammars are converted to an image in memory first; image() returns
+ * those bytes, which is what wlp4parse --compile-grammar writes out. The
+ * standard WLP4 grammar is also compiled into the program as an image in
+ * wlp4Tables.h (generated by wlp4parse --emit-tables), so it can be loaded
+ * without any file I/O.
+ *
+ * Grammar symbols are small integers: the terminals first, then the
+ * non-terminals, in the order WLP4.lr1 lists them. Names that are not in the
+ * grammar map to unknownSymbol(), whose column of the action table is all
+ * errors.
+ *
+ * Image layout, after the 8 byte magic "WLP4LR1\0" every field is a
+ * native-endian u32:
+ *   version, checksum          FNV-1a of every byte after the header
+ *   numTerminals, numNonTerminals, start, numRules, numStates, rhsSize,
+ *   nameBytes
+ *   nameEnd[numSymbols]        end offset of each symbol's name in names
+ *   ruleLhs[numRules]
+ *   ruleRhsEnd[numRules]       end offset of each rule's symbols in ruleRhs
+ *   ruleRhs[rhsSize]
+ *   action[numStates * (numSymbols + 1)]
+ *   char names[nameBytes]      padded to a multiple of 4
+ *
+ * Each action entry packs the kind of action into its top two bits and its
+ * target (the next state of a shift or goto, the rule of a reduce) into the
+ * rest. A missing entry is 0, an error whose target is state 0.
+ */
+class Grammar {
+ public:
+  enum ActionKind : uint32_t { ERROR = 0, SHIFT = 1, REDUCE = 2 };
+  static const uint32_t VERSION = 1;
+
+  static bool isImage(std::string_view data);
+
+  Grammar();
+  Grammar(const Grammar &) = delete;
+  Grammar &operator=(const Grammar &) = delete;
+
+  // Loads a grammar file in either format. Throws std::runtime_error if it
+  // cannot be read or is malformed.
+  void load(const std::string &path);
+  // Loads a grammar from the text format of WLP4.lr1.
+  void loadText(std::string_view text);
+  // Uses the WLP4 grammar compiled into the program from wlp4Tables.h.
+  void loadEmbedded();
+
+  std::string_view image() const { return data; }
+  // The checksum stored in the image, which identifies the grammar.
+  uint32_t imageChecksum() const;
+
+  int numSymbols() const { return numTerminals + numNonTerminals; }
+  int unknownSymbol() const { return numSymbols(); }
+  int start() const { return startSymbol; }
+  int lookupSymbol(std::string_view name) const;
+  std::string_view symbolName(int symbol) const;
+  bool isNonTerminal(int symbol) const {
+    return symbol >= int(numTerminals) && symbol < numSymbols();
+  }
+
+  int numRules() const { return rules; }
+  int ruleLhs(int r) const { return lhs[r]; }
+  int ruleLength(int r) const {
+    return rhsEnd[r] - (r == 0 ? 0 : rhsEnd[r - 1]);
+  }
+  // The i-th symbol on the right hand side of rule r.
+  int ruleRhs(int r, int i) const {
+    return rhs[(r == 0 ? 0 : rhsEnd[r - 1]) + i];
+  }
+
+  int numStates() const { return states; }
+  uint32_t lookupAction(int state, int symbol) const {
+    return action[size_t(state) * (numSymbols() + 1) + symbol];
+  }
+  static ActionKind actionKind(uint32_t entry) {
+    return ActionKind(entry >> ACTION_KIND_SHIFT);
+  }
+  static int actionTarget(uint32_t entry) {
+    return entry & ACTION_TARGET_MASK;
+  }
+  static uint32_t packAction(ActionKind kind, int target) {
+    return (uint32_t(kind) << ACTION_KIND_SHIFT) | uint32_t(target);
+  }
+
+ private:
+  static const int ACTION_KIND_SHIFT = 30;
+  static const uint32_t ACTION_TARGET_MASK = (1u << ACTION_KIND_SHIFT) - 1;
+
+  // Validates an image and points the accessors into it. The bytes must
+  // stay put for as long as the grammar is used.
+  void useImage(std::string_view image);
+
+  std::unique_ptr<SourceBuffer> file;  // a mapped image file
+  std::string built;                   // an image converted from text
+  std::string_view data;
+
+  uint32_t numTerminals, numNonTerminals, startSymbol, rules, states;
+  const uint32_t *nameEnd;
+  const uint32_t *lhs;
+  const uint32_t *rhsEnd;
+  const uint32_t *rhs;
+  const uint32_t *action;
+  const char *names;
+  std::unordered_map<std::string_view, int> symbolId;
+};
+
+#endif
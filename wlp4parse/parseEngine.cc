@@ -0,0 +1,56 @@
+#include "parseEngine.h"
+
+#include <iostream>
+#include <vector>
+
+void internGrammarKinds(const Grammar &grammar, ParseTree &tree) {
+  for (int sym = 0; sym <= grammar.numSymbols(); sym++) {
+    tree.internKind(grammar.symbolName(sym));
+  }
+}
+
+void rejectParse(size_t i, std::ostream &err) {
+  // Since BOF is not present in the input, it is not counted as a token
+  // when determining the length of the longest correct prefix.
+  err << "ERROR at " << i << std::endl;
+}
+
+TreeNode *reduceRule(const Grammar &grammar, ParseTree &tree, int r,
+                     std::vector<int> &stateStack,
+                     std::vector<TreeNode *> &treeStack) {
+  size_t length = grammar.ruleLength(r);
+  TreeNode *newNode =
+      tree.makeNode(grammar.ruleLhs(r), r,
+                    treeStack.data() + treeStack.size() - length, length);
+  treeStack.resize(treeStack.size() - length);
+  stateStack.resize(stateStack.size() - length);
+  return newNode;
+}
+
+void printPreOrder(const Grammar &grammar, const ParseTree &tree,
+                   const TreeNode *root, std::ostream &out) {
+  // Statements are left-recursive, so a tree is as deep as its longest
+  // statement list; walk it with an explicit stack.
+  std::vector<const TreeNode *> stack{root};
+  while (!stack.empty()) {
+    const TreeNode *node = stack.back();
+    stack.pop_back();
+    if (!node) {
+      continue;
+    }
+
+    if (grammar.isNonTerminal(node->kind)) {
+      out << tree.kindName(node) << " ";
+      for (const TreeNode *child : node->children()) {
+        out << tree.kindName(child) << " ";
+      }
+      out << '\n';
+    } else {
+      out << tree.kindName(node) << " " << tree.lexeme(node) << '\n';
+    }
+
+    for (size_t i = node->children().size(); i-- > 0;) {
+      stack.push_back(node->children()[i]);
+    }
+  }
+}
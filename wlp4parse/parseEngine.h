@@ -0,0 +1,153 @@
+#ifndef PARSEENGINE_H
+#define PARSEENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include "grammar.h"
+#include "parseTree.h"
+
+/*
+ * Helpers shared by the parse engines, which all build their trees in a
+ * ParseTree whose kind ids are the grammar's symbols.
+ */
+
+// Interns every symbol of grammar into the empty tree, in order, so that
+// each symbol's kind id is the symbol itself. unknownSymbol() gets the empty
+// name.
+void internGrammarKinds(const Grammar &grammar, ParseTree &tree);
+
+// Reports on err that the parser could not shift sequence[i]. The partial
+// trees need no cleanup; they are freed with the ParseTree. Shared by every
+// parse engine so they fail identically.
+void rejectParse(size_t i, std::ostream &err);
+
+// Pops the right hand side of rule r off both stacks and returns a new node
+// for its left hand side, stamped with r, with the popped trees as children,
+// in order.
+TreeNode *reduceRule(const Grammar &grammar, ParseTree &tree, int r,
+                     std::vector<int> &stateStack,
+                     std::vector<TreeNode *> &treeStack);
+
+// The LR(1) automaton of grammar, fed one leaf at a time, so that a parse
+// can start before the whole input has been scanned. Table is anything with
+// the lookupAction of Grammar: the grammar's own dense table or a
+// CompressedTable built from it. Every shift and reduce is written to trace,
+// if given.
+template <typename Table>
+class LRParser {
+ public:
+  // sizeHint is the expected number of leaves, if known.
+  LRParser(const Grammar &grammar, const Table &table, ParseTree &tree,
+           std::ostream *trace = nullptr, size_t sizeHint = 0)
+      : grammar(grammar),
+        table(table),
+        tree(tree),
+        trace(trace),
+        numShifted(0),
+        watchedRules(grammar.numRules(), false) {
+    stateStack.reserve(sizeHint + 1);
+    treeStack.reserve(sizeHint);
+    // push start state
+    stateStack.push_back(0);
+  }
+
+  // Has reduced(node) called with every node reduced by one of rules, as
+  // soon as it is built: a consumer can take each procedure, say, while the
+  // parser carries on with the rest of the input.
+  void watch(const std::vector<int> &rules,
+             std::function<void(TreeNode *)> reduced) {
+    for (int r : rules) {
+      watchedRules[r] = true;
+    }
+    onReduce = std::move(reduced);
+  }
+
+  // Shifts leaf, after every reduction it allows. Returns false if it cannot
+  // be shifted, in which case the leaf was the one at index position() and
+  // the parser must not be fed any more.
+  bool push(TreeNode *leaf) {
+    int sym = leaf->kind;
+    uint32_t entry = table.lookupAction(stateStack.back(), sym);
+    while (Grammar::actionKind(entry) == Grammar::REDUCE) {
+      if (trace) {
+        *trace << stateStack.back() << " " << tree.kindName(leaf)
+               << " reduce " << Grammar::actionTarget(entry) << std::endl;
+      }
+      int r = Grammar::actionTarget(entry);
+      TreeNode *node = reduceRule(grammar, tree, r, stateStack, treeStack);
+      if (watchedRules[r]) {
+        onReduce(node);
+      }
+      treeStack.push_back(node);
+      stateStack.push_back(Grammar::actionTarget(
+          table.lookupAction(stateStack.back(), grammar.ruleLhs(r))));
+      entry = table.lookupAction(stateStack.back(), sym);
+    }
+    // Reject if no suitable transition
+    if (Grammar::actionKind(entry) != Grammar::SHIFT) {
+      return false;
+    }
+    treeStack.push_back(leaf);
+
+    if (trace) {
+      *trace << stateStack.back() << " " << tree.kindName(leaf) << " shift "
+             << Grammar::actionTarget(entry) << std::endl;
+    }
+    stateStack.push_back(Grammar::actionTarget(entry));
+    numShifted++;
+    return true;
+  }
+
+  // The number of leaves shifted so far, which is also the index of the
+  // next one.
+  size_t position() const { return numShifted; }
+
+  // Accepts, once the last leaf (EOF) has been shifted, and returns the root.
+  TreeNode *finish() {
+    // Note that there is no reduce action for rule 0 in the LR(1) DFA, even
+    // though you are required to output the rule corresponding to this final
+    // reduction in your parser. Rule 0 will always be the unique rule which
+    // has the start symbol on the LHS.
+    return reduceRule(grammar, tree, 0, stateStack, treeStack);
+  }
+
+ private:
+  const Grammar &grammar;
+  const Table &table;
+  ParseTree &tree;
+  std::ostream *trace;
+  size_t numShifted;
+  std::vector<int> stateStack;
+  std::vector<TreeNode *> treeStack;
+  std::vector<bool> watchedRules;
+  std::function<void(TreeNode *)> onReduce;
+};
+
+// Runs the LR(1) automaton of grammar over the leaves BOF tokens EOF of
+// sequence and returns the root, or nullptr after reporting an error on err
+// with rejectParse. Table and trace are as for LRParser.
+template <typename Table>
+TreeNode *buildFromLR(const Grammar &grammar, const Table &table,
+                      ParseTree &tree, std::vector<TreeNode *> &sequence,
+                      std::ostream &err, std::ostream *trace = nullptr) {
+  LRParser<Table> parser(grammar, table, tree, trace, sequence.size());
+  for (TreeNode *leaf : sequence) {
+    if (!parser.push(leaf)) {
+      rejectParse(parser.position(), err);
+      return nullptr;
+    }
+  }
+  return parser.finish();
+}
+
+// Writes the tree below root in the preorder text format wlp4gen reads: a
+// line per node, "KIND lexeme" for a terminal and the production for a
+// nonterminal. Nothing is written for a null root.
+void printPreOrder(const Grammar &grammar, const ParseTree &tree,
+                   const TreeNode *root, std::ostream &out);
+
+#endif
@@ -0,0 +1,3767 @@
+// Generated by wlp4parse --emit-direct from WLP4.lr1. Do not edit.
+#include "wlp4Direct.h"
+
+const uint32_t DIRECT_GRAMMAR_CHECKSUM = 0xd3f9bde5;
+
+namespace {
+
+typedef std::vector<int> StateStack;
+typedef std::vector<TreeNode *> TreeStack;
+
+// start BOF procedures EOF
+TreeNode *reduce0(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(35, 0, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// procedures procedure procedures
+TreeNode *reduce1(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(42, 1, trees.data() + trees.size() - 2, 2);
+  trees.resize(trees.size() - 2);
+  states.resize(states.size() - 2);
+  return node;
+}
+
+// procedures main
+TreeNode *reduce2(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(42, 2, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// procedure INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
+TreeNode *reduce3(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(41, 3, trees.data() + trees.size() - 12, 12);
+  trees.resize(trees.size() - 12);
+  states.resize(states.size() - 12);
+  return node;
+}
+
+// main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
+TreeNode *reduce4(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(43, 4, trees.data() + trees.size() - 14, 14);
+  trees.resize(trees.size() - 14);
+  states.resize(states.size() - 14);
+  return node;
+}
+
+// params
+TreeNode *reduce5(ParseTree &tree, StateStack &, TreeStack &) {
+  TreeNode *node = tree.makeNode(44, 5, 0);
+  return node;
+}
+
+// params paramlist
+TreeNode *reduce6(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(44, 6, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// paramlist dcl
+TreeNode *reduce7(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(45, 7, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// paramlist dcl COMMA paramlist
+TreeNode *reduce8(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(45, 8, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// type INT
+TreeNode *reduce9(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(50, 9, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// type INT STAR
+TreeNode *reduce10(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(50, 10, trees.data() + trees.size() - 2, 2);
+  trees.resize(trees.size() - 2);
+  states.resize(states.size() - 2);
+  return node;
+}
+
+// dcls
+TreeNode *reduce11(ParseTree &tree, StateStack &, TreeStack &) {
+  TreeNode *node = tree.makeNode(37, 11, 0);
+  return node;
+}
+
+// dcls dcls dcl BECOMES NUM SEMI
+TreeNode *reduce12(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(37, 12, trees.data() + trees.size() - 5, 5);
+  trees.resize(trees.size() - 5);
+  states.resize(states.size() - 5);
+  return node;
+}
+
+// dcls dcls dcl BECOMES NULL SEMI
+TreeNode *reduce13(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(37, 13, trees.data() + trees.size() - 5, 5);
+  trees.resize(trees.size() - 5);
+  states.resize(states.size() - 5);
+  return node;
+}
+
+// dcl type ID
+TreeNode *reduce14(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(36, 14, trees.data() + trees.size() - 2, 2);
+  trees.resize(trees.size() - 2);
+  states.resize(states.size() - 2);
+  return node;
+}
+
+// statements
+TreeNode *reduce15(ParseTree &tree, StateStack &, TreeStack &) {
+  TreeNode *node = tree.makeNode(47, 15, 0);
+  return node;
+}
+
+// statements statements statement
+TreeNode *reduce16(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(47, 16, trees.data() + trees.size() - 2, 2);
+  trees.resize(trees.size() - 2);
+  states.resize(states.size() - 2);
+  return node;
+}
+
+// statement lvalue BECOMES expr SEMI
+TreeNode *reduce17(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(46, 17, trees.data() + trees.size() - 4, 4);
+  trees.resize(trees.size() - 4);
+  states.resize(states.size() - 4);
+  return node;
+}
+
+// statement IF LPAREN test RPAREN LBRACE statements RBRACE ELSE LBRACE statements RBRACE
+TreeNode *reduce18(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(46, 18, trees.data() + trees.size() - 11, 11);
+  trees.resize(trees.size() - 11);
+  states.resize(states.size() - 11);
+  return node;
+}
+
+// statement WHILE LPAREN test RPAREN LBRACE statements RBRACE
+TreeNode *reduce19(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(46, 19, trees.data() + trees.size() - 7, 7);
+  trees.resize(trees.size() - 7);
+  states.resize(states.size() - 7);
+  return node;
+}
+
+// statement PRINTLN LPAREN expr RPAREN SEMI
+TreeNode *reduce20(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(46, 20, trees.data() + trees.size() - 5, 5);
+  trees.resize(trees.size() - 5);
+  states.resize(states.size() - 5);
+  return node;
+}
+
+// statement DELETE LBRACK RBRACK expr SEMI
+TreeNode *reduce21(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(46, 21, trees.data() + trees.size() - 5, 5);
+  trees.resize(trees.size() - 5);
+  states.resize(states.size() - 5);
+  return node;
+}
+
+// test expr EQ expr
+TreeNode *reduce22(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(49, 22, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// test expr NE expr
+TreeNode *reduce23(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(49, 23, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// test expr LT expr
+TreeNode *reduce24(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(49, 24, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// test expr LE expr
+TreeNode *reduce25(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(49, 25, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// test expr GE expr
+TreeNode *reduce26(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(49, 26, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// test expr GT expr
+TreeNode *reduce27(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(49, 27, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// expr term
+TreeNode *reduce28(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(38, 28, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// expr expr PLUS term
+TreeNode *reduce29(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(38, 29, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// expr expr MINUS term
+TreeNode *reduce30(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(38, 30, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// term factor
+TreeNode *reduce31(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(48, 31, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// term term STAR factor
+TreeNode *reduce32(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(48, 32, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// term term SLASH factor
+TreeNode *reduce33(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(48, 33, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// term term PCT factor
+TreeNode *reduce34(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(48, 34, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// factor ID
+TreeNode *reduce35(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 35, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// factor NUM
+TreeNode *reduce36(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 36, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// factor NULL
+TreeNode *reduce37(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 37, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// factor LPAREN expr RPAREN
+TreeNode *reduce38(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 38, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// factor AMP lvalue
+TreeNode *reduce39(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 39, trees.data() + trees.size() - 2, 2);
+  trees.resize(trees.size() - 2);
+  states.resize(states.size() - 2);
+  return node;
+}
+
+// factor STAR factor
+TreeNode *reduce40(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 40, trees.data() + trees.size() - 2, 2);
+  trees.resize(trees.size() - 2);
+  states.resize(states.size() - 2);
+  return node;
+}
+
+// factor NEW INT LBRACK expr RBRACK
+TreeNode *reduce41(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 41, trees.data() + trees.size() - 5, 5);
+  trees.resize(trees.size() - 5);
+  states.resize(states.size() - 5);
+  return node;
+}
+
+// factor ID LPAREN RPAREN
+TreeNode *reduce42(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 42, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// factor ID LPAREN arglist RPAREN
+TreeNode *reduce43(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(39, 43, trees.data() + trees.size() - 4, 4);
+  trees.resize(trees.size() - 4);
+  states.resize(states.size() - 4);
+  return node;
+}
+
+// arglist expr
+TreeNode *reduce44(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(51, 44, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// arglist expr COMMA arglist
+TreeNode *reduce45(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(51, 45, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+// lvalue ID
+TreeNode *reduce46(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(40, 46, trees.data() + trees.size() - 1, 1);
+  trees.resize(trees.size() - 1);
+  states.resize(states.size() - 1);
+  return node;
+}
+
+// lvalue STAR factor
+TreeNode *reduce47(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(40, 47, trees.data() + trees.size() - 2, 2);
+  trees.resize(trees.size() - 2);
+  states.resize(states.size() - 2);
+  return node;
+}
+
+// lvalue LPAREN lvalue RPAREN
+TreeNode *reduce48(ParseTree &tree, StateStack &states, TreeStack &trees) {
+  TreeNode *node = tree.makeNode(40, 48, trees.data() + trees.size() - 3, 3);
+  trees.resize(trees.size() - 3);
+  states.resize(states.size() - 3);
+  return node;
+}
+
+}  // namespace
+
+TreeNode *parseDirect(ParseTree &tree, std::vector<TreeNode *> &sequence,
+                      std::ostream &err) {
+  StateStack states;
+  TreeStack trees;
+  states.reserve(sequence.size() + 1);
+  trees.reserve(sequence.size());
+  size_t i = 0;
+  int sym;
+
+  states.push_back(0);
+  goto state0;
+
+state0:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 2:  // BOF
+      trees.push_back(sequence[i++]);
+      states.push_back(23);
+      goto state23;
+  }
+  goto reject;
+
+state1:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(reduce6(tree, states, trees));
+      goto goto44;
+  }
+  goto reject;
+
+state2:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(64);
+      goto state64;
+  }
+  goto reject;
+
+state3:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce47(tree, states, trees));
+      goto goto40;
+  }
+  goto reject;
+
+state4:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(89);
+      goto state89;
+    case 10:  // ID
+      trees.push_back(reduce9(tree, states, trees));
+      goto goto50;
+  }
+  goto reject;
+
+state5:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(102);
+      goto state102;
+  }
+  goto reject;
+
+state6:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 12:  // INT
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce13(tree, states, trees));
+      goto goto37;
+  }
+  goto reject;
+
+state7:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 12:  // INT
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce12(tree, states, trees));
+      goto goto37;
+  }
+  goto reject;
+
+state8:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce37(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state9:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(36);
+      goto state36;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state10:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce31(tree, states, trees));
+      goto goto48;
+  }
+  goto reject;
+
+state11:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(46);
+      goto state46;
+    case 31:  // SLASH
+      trees.push_back(sequence[i++]);
+      states.push_back(52);
+      goto state52;
+    case 23:  // PCT
+      trees.push_back(sequence[i++]);
+      states.push_back(66);
+      goto state66;
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+      trees.push_back(reduce28(tree, states, trees));
+      goto goto38;
+  }
+  goto reject;
+
+state12:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 3:  // COMMA
+      trees.push_back(sequence[i++]);
+      states.push_back(85);
+      goto state85;
+    case 29:  // RPAREN
+      trees.push_back(reduce44(tree, states, trees));
+      goto goto51;
+  }
+  goto reject;
+
+state13:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(35);
+      goto state35;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state14:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(31);
+      goto state31;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state15:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(41);
+      goto state41;
+  }
+  goto reject;
+
+state16:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 30:  // SEMI
+      trees.push_back(sequence[i++]);
+      states.push_back(68);
+      goto state68;
+  }
+  goto reject;
+
+state17:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(33);
+      goto state33;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state18:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 41:  // procedure
+      trees.push_back(sequence[i++]);
+      states.push_back(18);
+      goto state18;
+    case 43:  // main
+      trees.push_back(sequence[i++]);
+      states.push_back(28);
+      goto state28;
+    case 42:  // procedures
+      trees.push_back(sequence[i++]);
+      states.push_back(39);
+      goto state39;
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(54);
+      goto state54;
+  }
+  goto reject;
+
+state19:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(60);
+      goto state60;
+  }
+  goto reject;
+
+state20:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(4);
+      goto state4;
+    case 36:  // dcl
+      trees.push_back(sequence[i++]);
+      states.push_back(29);
+      goto state29;
+    case 50:  // type
+      trees.push_back(sequence[i++]);
+      states.push_back(42);
+      goto state42;
+    case 45:  // paramlist
+      trees.push_back(sequence[i++]);
+      states.push_back(103);
+      goto state103;
+  }
+  goto reject;
+
+state21:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(4);
+      goto state4;
+    case 50:  // type
+      trees.push_back(sequence[i++]);
+      states.push_back(42);
+      goto state42;
+    case 36:  // dcl
+      trees.push_back(sequence[i++]);
+      states.push_back(63);
+      goto state63;
+    case 47:  // statements
+      trees.push_back(sequence[i++]);
+      states.push_back(109);
+      goto state109;
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce15(tree, states, trees));
+      goto goto47;
+  }
+  goto reject;
+
+state22:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(80);
+      goto state80;
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce35(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state23:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 41:  // procedure
+      trees.push_back(sequence[i++]);
+      states.push_back(18);
+      goto state18;
+    case 43:  // main
+      trees.push_back(sequence[i++]);
+      states.push_back(28);
+      goto state28;
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(54);
+      goto state54;
+    case 42:  // procedures
+      trees.push_back(sequence[i++]);
+      states.push_back(62);
+      goto state62;
+  }
+  goto reject;
+
+state24:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(4);
+      goto state4;
+    case 50:  // type
+      trees.push_back(sequence[i++]);
+      states.push_back(42);
+      goto state42;
+    case 36:  // dcl
+      trees.push_back(sequence[i++]);
+      states.push_back(101);
+      goto state101;
+  }
+  goto reject;
+
+state25:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(34);
+      goto state34;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state26:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(4);
+      goto state4;
+    case 50:  // type
+      trees.push_back(sequence[i++]);
+      states.push_back(42);
+      goto state42;
+    case 36:  // dcl
+      trees.push_back(sequence[i++]);
+      states.push_back(99);
+      goto state99;
+  }
+  goto reject;
+
+state27:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 26:  // RBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(91);
+      goto state91;
+  }
+  goto reject;
+
+state28:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 6:  // EOF
+      trees.push_back(reduce2(tree, states, trees));
+      goto goto42;
+  }
+  goto reject;
+
+state29:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 3:  // COMMA
+      trees.push_back(sequence[i++]);
+      states.push_back(20);
+      goto state20;
+    case 29:  // RPAREN
+      trees.push_back(reduce7(tree, states, trees));
+      goto goto45;
+  }
+  goto reject;
+
+state30:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce36(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state31:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 29:  // RPAREN
+      trees.push_back(reduce22(tree, states, trees));
+      goto goto49;
+  }
+  goto reject;
+
+state32:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 29:  // RPAREN
+      trees.push_back(reduce23(tree, states, trees));
+      goto goto49;
+  }
+  goto reject;
+
+state33:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 29:  // RPAREN
+      trees.push_back(reduce24(tree, states, trees));
+      goto goto49;
+  }
+  goto reject;
+
+state34:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 29:  // RPAREN
+      trees.push_back(reduce25(tree, states, trees));
+      goto goto49;
+  }
+  goto reject;
+
+state35:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 29:  // RPAREN
+      trees.push_back(reduce26(tree, states, trees));
+      goto goto49;
+  }
+  goto reject;
+
+state36:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 29:  // RPAREN
+      trees.push_back(reduce27(tree, states, trees));
+      goto goto49;
+  }
+  goto reject;
+
+state37:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 6:  // EOF
+      trees.push_back(reduce4(tree, states, trees));
+      goto goto43;
+  }
+  goto reject;
+
+state38:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(38);
+      goto state38;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(40);
+      goto state40;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(74);
+      goto state74;
+    case 40:  // lvalue
+      trees.push_back(sequence[i++]);
+      states.push_back(111);
+      goto state111;
+  }
+  goto reject;
+
+state39:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 6:  // EOF
+      trees.push_back(reduce1(tree, states, trees));
+      goto goto42;
+  }
+  goto reject;
+
+state40:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(3);
+      goto state3;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state41:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 14:  // LBRACK
+      trees.push_back(sequence[i++]);
+      states.push_back(118);
+      goto state118;
+  }
+  goto reject;
+
+state42:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(117);
+      goto state117;
+  }
+  goto reject;
+
+state43:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(105);
+      goto state105;
+  }
+  goto reject;
+
+state44:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(32);
+      goto state32;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state45:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(51);
+      goto state51;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(95);
+      goto state95;
+  }
+  goto reject;
+
+state46:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(47);
+      goto state47;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state47:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce32(tree, states, trees));
+      goto goto48;
+  }
+  goto reject;
+
+state48:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce33(tree, states, trees));
+      goto goto48;
+  }
+  goto reject;
+
+state49:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce34(tree, states, trees));
+      goto goto48;
+  }
+  goto reject;
+
+state50:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(90);
+      goto state90;
+  }
+  goto reject;
+
+state51:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 30:  // SEMI
+      trees.push_back(sequence[i++]);
+      states.push_back(7);
+      goto state7;
+  }
+  goto reject;
+
+state52:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(48);
+      goto state48;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state53:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(38);
+      goto state38;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(40);
+      goto state40;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(74);
+      goto state74;
+    case 40:  // lvalue
+      trees.push_back(sequence[i++]);
+      states.push_back(127);
+      goto state127;
+  }
+  goto reject;
+
+state54:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 33:  // WAIN
+      trees.push_back(sequence[i++]);
+      states.push_back(56);
+      goto state56;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(69);
+      goto state69;
+  }
+  goto reject;
+
+state55:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 14:  // LBRACK
+      trees.push_back(sequence[i++]);
+      states.push_back(79);
+      goto state79;
+  }
+  goto reject;
+
+state56:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(24);
+      goto state24;
+  }
+  goto reject;
+
+state57:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce16(tree, states, trees));
+      goto goto47;
+  }
+  goto reject;
+
+state58:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(106);
+      goto state106;
+  }
+  goto reject;
+
+state59:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(4);
+      goto state4;
+    case 50:  // type
+      trees.push_back(sequence[i++]);
+      states.push_back(42);
+      goto state42;
+    case 36:  // dcl
+      trees.push_back(sequence[i++]);
+      states.push_back(63);
+      goto state63;
+    case 47:  // statements
+      trees.push_back(sequence[i++]);
+      states.push_back(129);
+      goto state129;
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce15(tree, states, trees));
+      goto goto47;
+  }
+  goto reject;
+
+state60:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(46);
+      goto state46;
+    case 31:  // SLASH
+      trees.push_back(sequence[i++]);
+      states.push_back(52);
+      goto state52;
+    case 23:  // PCT
+      trees.push_back(sequence[i++]);
+      states.push_back(66);
+      goto state66;
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+      trees.push_back(reduce29(tree, states, trees));
+      goto goto38;
+  }
+  goto reject;
+
+state61:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(46);
+      goto state46;
+    case 31:  // SLASH
+      trees.push_back(sequence[i++]);
+      states.push_back(52);
+      goto state52;
+    case 23:  // PCT
+      trees.push_back(sequence[i++]);
+      states.push_back(66);
+      goto state66;
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+      trees.push_back(reduce30(tree, states, trees));
+      goto goto38;
+  }
+  goto reject;
+
+state62:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 6:  // EOF
+      trees.push_back(sequence[i++]);
+      states.push_back(98);
+      goto state98;
+  }
+  goto reject;
+
+state63:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+      trees.push_back(sequence[i++]);
+      states.push_back(45);
+      goto state45;
+  }
+  goto reject;
+
+state64:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(97);
+      goto state97;
+  }
+  goto reject;
+
+state65:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 27:  // RBRACK
+      trees.push_back(sequence[i++]);
+      states.push_back(116);
+      goto state116;
+  }
+  goto reject;
+
+state66:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(49);
+      goto state49;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+  }
+  goto reject;
+
+state67:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+      trees.push_back(sequence[i++]);
+      states.push_back(86);
+      goto state86;
+  }
+  goto reject;
+
+state68:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce20(tree, states, trees));
+      goto goto46;
+  }
+  goto reject;
+
+state69:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(112);
+      goto state112;
+  }
+  goto reject;
+
+state70:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(121);
+      goto state121;
+  }
+  goto reject;
+
+state71:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(61);
+      goto state61;
+  }
+  goto reject;
+
+state72:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(reduce45(tree, states, trees));
+      goto goto51;
+  }
+  goto reject;
+
+state73:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(75);
+      goto state75;
+  }
+  goto reject;
+
+state74:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce46(tree, states, trees));
+      goto goto40;
+  }
+  goto reject;
+
+state75:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 30:  // SEMI
+      trees.push_back(sequence[i++]);
+      states.push_back(87);
+      goto state87;
+  }
+  goto reject;
+
+state76:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 47:  // statements
+      trees.push_back(sequence[i++]);
+      states.push_back(114);
+      goto state114;
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce15(tree, states, trees));
+      goto goto47;
+  }
+  goto reject;
+
+state77:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 47:  // statements
+      trees.push_back(sequence[i++]);
+      states.push_back(113);
+      goto state113;
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce15(tree, states, trees));
+      goto goto47;
+  }
+  goto reject;
+
+state78:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 47:  // statements
+      trees.push_back(sequence[i++]);
+      states.push_back(115);
+      goto state115;
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce15(tree, states, trees));
+      goto goto47;
+  }
+  goto reject;
+
+state79:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 27:  // RBRACK
+      trees.push_back(sequence[i++]);
+      states.push_back(88);
+      goto state88;
+  }
+  goto reject;
+
+state80:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(12);
+      goto state12;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 51:  // arglist
+      trees.push_back(sequence[i++]);
+      states.push_back(50);
+      goto state50;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(93);
+      goto state93;
+  }
+  goto reject;
+
+state81:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 5:  // ELSE
+      trees.push_back(sequence[i++]);
+      states.push_back(96);
+      goto state96;
+  }
+  goto reject;
+
+state82:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce19(tree, states, trees));
+      goto goto46;
+  }
+  goto reject;
+
+state83:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce18(tree, states, trees));
+      goto goto46;
+  }
+  goto reject;
+
+state84:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(110);
+      goto state110;
+  }
+  goto reject;
+
+state85:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(12);
+      goto state12;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 51:  // arglist
+      trees.push_back(sequence[i++]);
+      states.push_back(72);
+      goto state72;
+  }
+  goto reject;
+
+state86:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(124);
+      goto state124;
+  }
+  goto reject;
+
+state87:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 26:  // RBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(37);
+      goto state37;
+  }
+  goto reject;
+
+state88:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(122);
+      goto state122;
+  }
+  goto reject;
+
+state89:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 10:  // ID
+      trees.push_back(reduce10(tree, states, trees));
+      goto goto50;
+  }
+  goto reject;
+
+state90:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce43(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state91:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 12:  // INT
+      trees.push_back(reduce3(tree, states, trees));
+      goto goto41;
+  }
+  goto reject;
+
+state92:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 13:  // LBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(94);
+      goto state94;
+  }
+  goto reject;
+
+state93:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce42(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state94:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 37:  // dcls
+      trees.push_back(sequence[i++]);
+      states.push_back(21);
+      goto state21;
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 12:  // INT
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce11(tree, states, trees));
+      goto goto37;
+  }
+  goto reject;
+
+state95:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 30:  // SEMI
+      trees.push_back(sequence[i++]);
+      states.push_back(6);
+      goto state6;
+  }
+  goto reject;
+
+state96:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 13:  // LBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(78);
+      goto state78;
+  }
+  goto reject;
+
+state97:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce38(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state98:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+  }
+  goto reject;
+
+state99:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(92);
+      goto state92;
+  }
+  goto reject;
+
+state100:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce48(tree, states, trees));
+      goto goto40;
+  }
+  goto reject;
+
+state101:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 3:  // COMMA
+      trees.push_back(sequence[i++]);
+      states.push_back(26);
+      goto state26;
+  }
+  goto reject;
+
+state102:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce40(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state103:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(reduce8(tree, states, trees));
+      goto goto45;
+  }
+  goto reject;
+
+state104:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(108);
+      goto state108;
+    case 49:  // test
+      trees.push_back(sequence[i++]);
+      states.push_back(120);
+      goto state120;
+  }
+  goto reject;
+
+state105:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(108);
+      goto state108;
+    case 49:  // test
+      trees.push_back(sequence[i++]);
+      states.push_back(119);
+      goto state119;
+  }
+  goto reject;
+
+state106:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(123);
+      goto state123;
+  }
+  goto reject;
+
+state107:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(104);
+      goto state104;
+  }
+  goto reject;
+
+state108:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 9:  // GT
+      trees.push_back(sequence[i++]);
+      states.push_back(9);
+      goto state9;
+    case 8:  // GE
+      trees.push_back(sequence[i++]);
+      states.push_back(13);
+      goto state13;
+    case 7:  // EQ
+      trees.push_back(sequence[i++]);
+      states.push_back(14);
+      goto state14;
+    case 17:  // LT
+      trees.push_back(sequence[i++]);
+      states.push_back(17);
+      goto state17;
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 15:  // LE
+      trees.push_back(sequence[i++]);
+      states.push_back(25);
+      goto state25;
+    case 19:  // NE
+      trees.push_back(sequence[i++]);
+      states.push_back(44);
+      goto state44;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+  }
+  goto reject;
+
+state109:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(38);
+      goto state38;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(40);
+      goto state40;
+    case 34:  // WHILE
+      trees.push_back(sequence[i++]);
+      states.push_back(43);
+      goto state43;
+    case 4:  // DELETE
+      trees.push_back(sequence[i++]);
+      states.push_back(55);
+      goto state55;
+    case 46:  // statement
+      trees.push_back(sequence[i++]);
+      states.push_back(57);
+      goto state57;
+    case 25:  // PRINTLN
+      trees.push_back(sequence[i++]);
+      states.push_back(58);
+      goto state58;
+    case 40:  // lvalue
+      trees.push_back(sequence[i++]);
+      states.push_back(67);
+      goto state67;
+    case 28:  // RETURN
+      trees.push_back(sequence[i++]);
+      states.push_back(73);
+      goto state73;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(74);
+      goto state74;
+    case 11:  // IF
+      trees.push_back(sequence[i++]);
+      states.push_back(107);
+      goto state107;
+  }
+  goto reject;
+
+state110:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 13:  // LBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(128);
+      goto state128;
+  }
+  goto reject;
+
+state111:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(100);
+      goto state100;
+  }
+  goto reject;
+
+state112:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 45:  // paramlist
+      trees.push_back(sequence[i++]);
+      states.push_back(1);
+      goto state1;
+    case 12:  // INT
+      trees.push_back(sequence[i++]);
+      states.push_back(4);
+      goto state4;
+    case 36:  // dcl
+      trees.push_back(sequence[i++]);
+      states.push_back(29);
+      goto state29;
+    case 50:  // type
+      trees.push_back(sequence[i++]);
+      states.push_back(42);
+      goto state42;
+    case 44:  // params
+      trees.push_back(sequence[i++]);
+      states.push_back(84);
+      goto state84;
+    case 29:  // RPAREN
+      trees.push_back(reduce5(tree, states, trees));
+      goto goto44;
+  }
+  goto reject;
+
+state113:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(38);
+      goto state38;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(40);
+      goto state40;
+    case 34:  // WHILE
+      trees.push_back(sequence[i++]);
+      states.push_back(43);
+      goto state43;
+    case 4:  // DELETE
+      trees.push_back(sequence[i++]);
+      states.push_back(55);
+      goto state55;
+    case 46:  // statement
+      trees.push_back(sequence[i++]);
+      states.push_back(57);
+      goto state57;
+    case 25:  // PRINTLN
+      trees.push_back(sequence[i++]);
+      states.push_back(58);
+      goto state58;
+    case 40:  // lvalue
+      trees.push_back(sequence[i++]);
+      states.push_back(67);
+      goto state67;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(74);
+      goto state74;
+    case 26:  // RBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(81);
+      goto state81;
+    case 11:  // IF
+      trees.push_back(sequence[i++]);
+      states.push_back(107);
+      goto state107;
+  }
+  goto reject;
+
+state114:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(38);
+      goto state38;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(40);
+      goto state40;
+    case 34:  // WHILE
+      trees.push_back(sequence[i++]);
+      states.push_back(43);
+      goto state43;
+    case 4:  // DELETE
+      trees.push_back(sequence[i++]);
+      states.push_back(55);
+      goto state55;
+    case 46:  // statement
+      trees.push_back(sequence[i++]);
+      states.push_back(57);
+      goto state57;
+    case 25:  // PRINTLN
+      trees.push_back(sequence[i++]);
+      states.push_back(58);
+      goto state58;
+    case 40:  // lvalue
+      trees.push_back(sequence[i++]);
+      states.push_back(67);
+      goto state67;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(74);
+      goto state74;
+    case 26:  // RBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(82);
+      goto state82;
+    case 11:  // IF
+      trees.push_back(sequence[i++]);
+      states.push_back(107);
+      goto state107;
+  }
+  goto reject;
+
+state115:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(38);
+      goto state38;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(40);
+      goto state40;
+    case 34:  // WHILE
+      trees.push_back(sequence[i++]);
+      states.push_back(43);
+      goto state43;
+    case 4:  // DELETE
+      trees.push_back(sequence[i++]);
+      states.push_back(55);
+      goto state55;
+    case 46:  // statement
+      trees.push_back(sequence[i++]);
+      states.push_back(57);
+      goto state57;
+    case 25:  // PRINTLN
+      trees.push_back(sequence[i++]);
+      states.push_back(58);
+      goto state58;
+    case 40:  // lvalue
+      trees.push_back(sequence[i++]);
+      states.push_back(67);
+      goto state67;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(74);
+      goto state74;
+    case 26:  // RBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(83);
+      goto state83;
+    case 11:  // IF
+      trees.push_back(sequence[i++]);
+      states.push_back(107);
+      goto state107;
+  }
+  goto reject;
+
+state116:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce41(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state117:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 29:  // RPAREN
+      trees.push_back(reduce14(tree, states, trees));
+      goto goto36;
+  }
+  goto reject;
+
+state118:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(2);
+      goto state2;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(5);
+      goto state5;
+    case 21:  // NULL
+      trees.push_back(sequence[i++]);
+      states.push_back(8);
+      goto state8;
+    case 39:  // factor
+      trees.push_back(sequence[i++]);
+      states.push_back(10);
+      goto state10;
+    case 48:  // term
+      trees.push_back(sequence[i++]);
+      states.push_back(11);
+      goto state11;
+    case 20:  // NEW
+      trees.push_back(sequence[i++]);
+      states.push_back(15);
+      goto state15;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(22);
+      goto state22;
+    case 22:  // NUM
+      trees.push_back(sequence[i++]);
+      states.push_back(30);
+      goto state30;
+    case 0:  // AMP
+      trees.push_back(sequence[i++]);
+      states.push_back(53);
+      goto state53;
+    case 38:  // expr
+      trees.push_back(sequence[i++]);
+      states.push_back(65);
+      goto state65;
+  }
+  goto reject;
+
+state119:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(126);
+      goto state126;
+  }
+  goto reject;
+
+state120:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(125);
+      goto state125;
+  }
+  goto reject;
+
+state121:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 30:  // SEMI
+      trees.push_back(sequence[i++]);
+      states.push_back(27);
+      goto state27;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+  }
+  goto reject;
+
+state122:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 30:  // SEMI
+      trees.push_back(sequence[i++]);
+      states.push_back(131);
+      goto state131;
+  }
+  goto reject;
+
+state123:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 29:  // RPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(16);
+      goto state16;
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+  }
+  goto reject;
+
+state124:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 24:  // PLUS
+      trees.push_back(sequence[i++]);
+      states.push_back(19);
+      goto state19;
+    case 18:  // MINUS
+      trees.push_back(sequence[i++]);
+      states.push_back(71);
+      goto state71;
+    case 30:  // SEMI
+      trees.push_back(sequence[i++]);
+      states.push_back(130);
+      goto state130;
+  }
+  goto reject;
+
+state125:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 13:  // LBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(77);
+      goto state77;
+  }
+  goto reject;
+
+state126:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 13:  // LBRACE
+      trees.push_back(sequence[i++]);
+      states.push_back(76);
+      goto state76;
+  }
+  goto reject;
+
+state127:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 1:  // BECOMES
+    case 3:  // COMMA
+    case 7:  // EQ
+    case 8:  // GE
+    case 9:  // GT
+    case 15:  // LE
+    case 17:  // LT
+    case 18:  // MINUS
+    case 19:  // NE
+    case 23:  // PCT
+    case 24:  // PLUS
+    case 27:  // RBRACK
+    case 29:  // RPAREN
+    case 30:  // SEMI
+    case 31:  // SLASH
+    case 32:  // STAR
+      trees.push_back(reduce39(tree, states, trees));
+      goto goto39;
+  }
+  goto reject;
+
+state128:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 37:  // dcls
+      trees.push_back(sequence[i++]);
+      states.push_back(59);
+      goto state59;
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 12:  // INT
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce11(tree, states, trees));
+      goto goto37;
+  }
+  goto reject;
+
+state129:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 16:  // LPAREN
+      trees.push_back(sequence[i++]);
+      states.push_back(38);
+      goto state38;
+    case 32:  // STAR
+      trees.push_back(sequence[i++]);
+      states.push_back(40);
+      goto state40;
+    case 34:  // WHILE
+      trees.push_back(sequence[i++]);
+      states.push_back(43);
+      goto state43;
+    case 4:  // DELETE
+      trees.push_back(sequence[i++]);
+      states.push_back(55);
+      goto state55;
+    case 46:  // statement
+      trees.push_back(sequence[i++]);
+      states.push_back(57);
+      goto state57;
+    case 25:  // PRINTLN
+      trees.push_back(sequence[i++]);
+      states.push_back(58);
+      goto state58;
+    case 40:  // lvalue
+      trees.push_back(sequence[i++]);
+      states.push_back(67);
+      goto state67;
+    case 28:  // RETURN
+      trees.push_back(sequence[i++]);
+      states.push_back(70);
+      goto state70;
+    case 10:  // ID
+      trees.push_back(sequence[i++]);
+      states.push_back(74);
+      goto state74;
+    case 11:  // IF
+      trees.push_back(sequence[i++]);
+      states.push_back(107);
+      goto state107;
+  }
+  goto reject;
+
+state130:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce17(tree, states, trees));
+      goto goto46;
+  }
+  goto reject;
+
+state131:
+  if (i == sequence.size()) goto accept;
+  sym = sequence[i]->kind;
+  switch (sym) {
+    case 4:  // DELETE
+    case 10:  // ID
+    case 11:  // IF
+    case 16:  // LPAREN
+    case 25:  // PRINTLN
+    case 26:  // RBRACE
+    case 28:  // RETURN
+    case 32:  // STAR
+    case 34:  // WHILE
+      trees.push_back(reduce21(tree, states, trees));
+      goto goto46;
+  }
+  goto reject;
+
+goto36:  // dcl
+  switch (states.back()) {
+    case 20: states.push_back(29); goto state29;
+    case 21: states.push_back(63); goto state63;
+    case 24: states.push_back(101); goto state101;
+    case 26: states.push_back(99); goto state99;
+    case 59: states.push_back(63); goto state63;
+    case 112: states.push_back(29); goto state29;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto37:  // dcls
+  switch (states.back()) {
+    case 94: states.push_back(21); goto state21;
+    case 128: states.push_back(59); goto state59;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto38:  // expr
+  switch (states.back()) {
+    case 2: states.push_back(64); goto state64;
+    case 9: states.push_back(36); goto state36;
+    case 13: states.push_back(35); goto state35;
+    case 14: states.push_back(31); goto state31;
+    case 17: states.push_back(33); goto state33;
+    case 25: states.push_back(34); goto state34;
+    case 44: states.push_back(32); goto state32;
+    case 70: states.push_back(121); goto state121;
+    case 73: states.push_back(75); goto state75;
+    case 80: states.push_back(12); goto state12;
+    case 85: states.push_back(12); goto state12;
+    case 86: states.push_back(124); goto state124;
+    case 88: states.push_back(122); goto state122;
+    case 104: states.push_back(108); goto state108;
+    case 105: states.push_back(108); goto state108;
+    case 106: states.push_back(123); goto state123;
+    case 118: states.push_back(65); goto state65;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto39:  // factor
+  switch (states.back()) {
+    case 2: states.push_back(10); goto state10;
+    case 5: states.push_back(102); goto state102;
+    case 9: states.push_back(10); goto state10;
+    case 13: states.push_back(10); goto state10;
+    case 14: states.push_back(10); goto state10;
+    case 17: states.push_back(10); goto state10;
+    case 19: states.push_back(10); goto state10;
+    case 25: states.push_back(10); goto state10;
+    case 40: states.push_back(3); goto state3;
+    case 44: states.push_back(10); goto state10;
+    case 46: states.push_back(47); goto state47;
+    case 52: states.push_back(48); goto state48;
+    case 66: states.push_back(49); goto state49;
+    case 70: states.push_back(10); goto state10;
+    case 71: states.push_back(10); goto state10;
+    case 73: states.push_back(10); goto state10;
+    case 80: states.push_back(10); goto state10;
+    case 85: states.push_back(10); goto state10;
+    case 86: states.push_back(10); goto state10;
+    case 88: states.push_back(10); goto state10;
+    case 104: states.push_back(10); goto state10;
+    case 105: states.push_back(10); goto state10;
+    case 106: states.push_back(10); goto state10;
+    case 118: states.push_back(10); goto state10;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto40:  // lvalue
+  switch (states.back()) {
+    case 38: states.push_back(111); goto state111;
+    case 53: states.push_back(127); goto state127;
+    case 109: states.push_back(67); goto state67;
+    case 113: states.push_back(67); goto state67;
+    case 114: states.push_back(67); goto state67;
+    case 115: states.push_back(67); goto state67;
+    case 129: states.push_back(67); goto state67;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto41:  // procedure
+  switch (states.back()) {
+    case 18: states.push_back(18); goto state18;
+    case 23: states.push_back(18); goto state18;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto42:  // procedures
+  switch (states.back()) {
+    case 18: states.push_back(39); goto state39;
+    case 23: states.push_back(62); goto state62;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto43:  // main
+  switch (states.back()) {
+    case 18: states.push_back(28); goto state28;
+    case 23: states.push_back(28); goto state28;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto44:  // params
+  switch (states.back()) {
+    case 112: states.push_back(84); goto state84;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto45:  // paramlist
+  switch (states.back()) {
+    case 20: states.push_back(103); goto state103;
+    case 112: states.push_back(1); goto state1;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto46:  // statement
+  switch (states.back()) {
+    case 109: states.push_back(57); goto state57;
+    case 113: states.push_back(57); goto state57;
+    case 114: states.push_back(57); goto state57;
+    case 115: states.push_back(57); goto state57;
+    case 129: states.push_back(57); goto state57;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto47:  // statements
+  switch (states.back()) {
+    case 21: states.push_back(109); goto state109;
+    case 59: states.push_back(129); goto state129;
+    case 76: states.push_back(114); goto state114;
+    case 77: states.push_back(113); goto state113;
+    case 78: states.push_back(115); goto state115;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto48:  // term
+  switch (states.back()) {
+    case 2: states.push_back(11); goto state11;
+    case 9: states.push_back(11); goto state11;
+    case 13: states.push_back(11); goto state11;
+    case 14: states.push_back(11); goto state11;
+    case 17: states.push_back(11); goto state11;
+    case 19: states.push_back(60); goto state60;
+    case 25: states.push_back(11); goto state11;
+    case 44: states.push_back(11); goto state11;
+    case 70: states.push_back(11); goto state11;
+    case 71: states.push_back(61); goto state61;
+    case 73: states.push_back(11); goto state11;
+    case 80: states.push_back(11); goto state11;
+    case 85: states.push_back(11); goto state11;
+    case 86: states.push_back(11); goto state11;
+    case 88: states.push_back(11); goto state11;
+    case 104: states.push_back(11); goto state11;
+    case 105: states.push_back(11); goto state11;
+    case 106: states.push_back(11); goto state11;
+    case 118: states.push_back(11); goto state11;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto49:  // test
+  switch (states.back()) {
+    case 104: states.push_back(120); goto state120;
+    case 105: states.push_back(119); goto state119;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto50:  // type
+  switch (states.back()) {
+    case 20: states.push_back(42); goto state42;
+    case 21: states.push_back(42); goto state42;
+    case 24: states.push_back(42); goto state42;
+    case 26: states.push_back(42); goto state42;
+    case 59: states.push_back(42); goto state42;
+    case 112: states.push_back(42); goto state42;
+  }
+  states.push_back(0);
+  goto state0;
+
+goto51:  // arglist
+  switch (states.back()) {
+    case 80: states.push_back(50); goto state50;
+    case 85: states.push_back(72); goto state72;
+  }
+  states.push_back(0);
+  goto state0;
+
+reject:
+  rejectParse(i, err);
+  return nullptr;
+
+accept:
+  return reduce0(tree, states, trees);
+}
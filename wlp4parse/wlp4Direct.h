@@ -0,0 +1,34 @@
+#ifndef WLP4DIRECT_H
+#define WLP4DIRECT_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "parseEngine.h"
+
+/*
+ * A direct-coded LR(1) parser for WLP4, generated into wlp4Direct.cc by
+ * wlp4parse --emit-direct.
+ *
+ * It runs the same automaton as buildFromLR in parseEngine.h, but instead of
+ * looking actions up in a table, every state is a block of code with a
+ * switch on the lookahead symbol, shifts jump straight to the block of the
+ * next state, and every rule has its own reduce function that builds a node
+ * of that rule's arity. The result, and any error, is exactly that of
+ * buildFromLR.
+ *
+ * Symbol ids are baked into the generated code, so the tree's kinds must
+ * have been interned by internGrammarKinds from the grammar it was generated
+ * from; check DIRECT_GRAMMAR_CHECKSUM against Grammar::imageChecksum().
+ */
+
+extern const uint32_t DIRECT_GRAMMAR_CHECKSUM;
+
+// Parses the leaves BOF tokens EOF of tree, building the interior nodes in
+// it. Returns the root, or nullptr after reporting an error on err with
+// rejectParse.
+TreeNode *parseDirect(ParseTree &tree, std::vector<TreeNode *> &sequence,
+                      std::ostream &err);
+
+#endif
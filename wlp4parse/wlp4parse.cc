@@ -1,272 +1,388 @@
-#include <fstream>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
 #include <iostream>
-#include <sstream>
-#include <stack>
-#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-using namespace std;
-
-//=========
-bool debug = false;
-//=========
+#include "compressedTable.h"
+#include "generators.h"
+#include "grammar.h"
+#include "parseEngine.h"
+#include "parseTree.h"
+#include "sourceBuffer.h"
+#include "tokenStream.h"
+#include "treeStream.h"
+#include "wlp4Direct.h"
 
-unordered_map<string, bool> terminal;
-unordered_map<string, bool> nonTerminal;
-string start;
-vector<pair<string, vector<string>>> rule;
-unordered_map<int, unordered_map<string, pair<string, int>>> action;
+using namespace std;
 
-struct TreeNode {
-  string val;
-  string lexeme;  // TreeNode should have either lexeme or children
-  vector<TreeNode *> children;
-  TreeNode() : val(0), children({}) {}
-  TreeNode(string x) : val(x), children({}) {}
-  TreeNode(string x, int length) : val(x), children(length, nullptr) {}
-  TreeNode(string x, string l) : val(x), lexeme(l) {}
-};
+bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r'; }
 
-void deleteTree(TreeNode *root) {
-  if (!root) {
-    return;
+// Returns the next whitespace separated word of source at or after posn,
+// like cin >> word but without copying it out of the buffer.
+string_view nextWord(string_view source, size_t &posn) {
+  while (posn < source.size() && isSpace(source[posn])) {
+    posn++;
   }
-
-  for (int i = 0; i < root->children.size(); i++) {
-    deleteTree(root->children[i]);
+  size_t begin = posn;
+  while (posn < source.size() && !isSpace(source[posn])) {
+    posn++;
   }
-
-  delete root;
-}
-
-// Skip the grammar part of the input.
-void skipLine(fstream &in) {
-  string s;
-  getline(in, s);
+  return source.substr(begin, posn - begin);
 }
 
-void recordGrammar(fstream &in) {
-  int i, numTerm, numNonTerm, numRule, numState, numAction;
+// Reads the tokens produced by wlp4scan, either as "KIND lexeme" pairs or
+// in the binary format of tokenStream.h, as leaves of tree. The tree's kinds
+// must be the grammar's symbols (see internGrammarKinds); a token kind that
+// is not in the grammar becomes unknownSymbol().
+vector<TreeNode *> readCode(const Grammar &grammar, const SourceBuffer &source,
+                            ParseTree &tree) {
+  string_view input = source.view();
+  size_t posn = 0;
 
-  // read the number of terminals and move to the next line
-  in >> numTerm;
-  skipLine(in);
+  vector<TreeNode *> s;
+  s.push_back(tree.makeLeaf(grammar.lookupSymbol("BOF"), "BOF"));
 
-  // record terminals
-  for (int i = 0; i < numTerm; i++) {
-    string t;
-    in >> t;
-    terminal[t] = true;
-    skipLine(in);
-  }
+  if (TokenStreamReader::isTokenStream(input)) {
+    TokenStreamReader reader(input);
 
-  // read the number of non-terminals and move to the next line
-  in >> numNonTerm;
-  skipLine(in);
+    // The stream names each of its kinds once, so look them up once.
+    vector<int> kindSymbol;
+    for (uint32_t k = 0; k < reader.kindCount(); k++) {
+      kindSymbol.push_back(grammar.lookupSymbol(reader.kindName(k)));
+    }
 
-  // record non-terminals
-  for (i = 0; i < numNonTerm; i++) {
-    string n;
-    in >> n;
-    nonTerminal[n] = true;
-    skipLine(in);
+    s.reserve(reader.size() + 2);
+    for (size_t i = 0; i < reader.size(); i++) {
+      TokenRecord r = reader.record(i);
+      s.push_back(tree.makeLeaf(kindSymbol[r.kind], reader.string(r.lexeme)));
+    }
+    s.push_back(tree.makeLeaf(grammar.lookupSymbol("EOF"), "EOF"));
+    return s;
   }
 
-  // skip the line containing the start symbol
-  in >> start;
-  skipLine(in);
-
-  // read the number of rules and move to the next line
-  in >> numRule;
-  skipLine(in);
-
-  // read production rules
-  for (i = 0; i < numRule; i++) {
-    string token;
-    string line;
-    getline(in, line);
-    stringstream ss(line);
-
-    ss >> token;
-    rule.push_back({token, {}});
-
-    while (ss >> token) {
-      rule.back().second.push_back(token);
+  while (true) {
+    string_view token = nextWord(input, posn);
+    if (token.empty()) {
+      break;
     }
+    string_view lexeme = nextWord(input, posn);
+    s.push_back(tree.makeLeaf(grammar.lookupSymbol(token), lexeme));
   }
 
-  in >> numState;
-  skipLine(in);
-  in >> numAction;
-  skipLine(in);
-  // If the DFA is in state, and terminal is first in the unread input, reduce
-  // by rule number rule
-
-  // If the DFA is in state1, shift symbol and transition to state2
-  for (int i = 0; i < numAction; i++) {
-    int state;
-    string item;
-    string reduceOrShift;
-    int ruleOrState;
-    in >> state;
-    in >> item;
-    in >> reduceOrShift;
-    in >> ruleOrState;
+  s.push_back(tree.makeLeaf(grammar.lookupSymbol("EOF"), "EOF"));
 
-    action[state][item] = {reduceOrShift, ruleOrState};
-  }
+  return s;
 }
 
-vector<TreeNode *> readCode() {
-  string token;
-  string lexeme;
-
-  vector<TreeNode *> s;
-  s.push_back(new TreeNode("BOF", "BOF"));
-
-  while (cin >> token) {
-    cin >> lexeme;
-    s.push_back(new TreeNode(token, lexeme));
+// The parse engines, selected with --engine by name, over one grammar.
+// Errors are reported on cerr, and every shift and reduce of the table
+// engines is written to trace, if given.
+class ParseEngines {
+ public:
+  explicit ParseEngines(const Grammar &grammar, ostream *trace = nullptr)
+      : grammar(grammar), trace(trace) {}
+
+  TreeNode *parse(const string &engine, ParseTree &tree,
+                  vector<TreeNode *> &sequence) {
+    if (engine == "direct") {
+      return parseDirect(tree, sequence, cerr);
+    } else if (engine == "compressed") {
+      return buildFromLR(grammar, compressedTable(), tree, sequence, cerr,
+                         trace);
+    }
+    return buildFromLR(grammar, grammar, tree, sequence, cerr, trace);
   }
 
-  s.push_back(new TreeNode("EOF", "EOF"));
+  // Built the first time it is needed.
+  const CompressedTable &compressedTable() {
+    if (!compressed) {
+      compressed.reset(new CompressedTable(grammar));
+    }
+    return *compressed;
+  }
 
-  return s;
-}
+ private:
+  const Grammar &grammar;
+  ostream *trace;
+  unique_ptr<CompressedTable> compressed;
+};
 
-void printDerivation(TreeNode *root) {
-  if (!root) {
-    return;
+// Tree walks use explicit stacks: statements are left-recursive, so a tree
+// is as deep as its longest statement list.
+
+// Compares trees from different ParseTrees, whose lexeme ids may differ.
+bool sameTree(const ParseTree &ta, const TreeNode *a, const ParseTree &tb,
+              const TreeNode *b) {
+  vector<pair<const TreeNode *, const TreeNode *>> stack{{a, b}};
+  while (!stack.empty()) {
+    auto [x, y] = stack.back();
+    stack.pop_back();
+    if (x->kind != y->kind || x->rule != y->rule ||
+        ta.lexeme(x) != tb.lexeme(y) ||
+        x->children().size() != y->children().size()) {
+      return false;
+    }
+    for (size_t i = 0; i < x->children().size(); i++) {
+      stack.emplace_back(x->children()[i], y->children()[i]);
+    }
   }
+  return true;
+}
 
-  for (int i = 0; i < root->children.size(); i++) {
-    printDerivation(root->children[i]);
+// Tokens of a made-up WLP4 program with the given number of statements in
+// wain, as wlp4scan would print them, for benchmarking without input files.
+// With nesting, one more statement is buried that many if blocks deep and
+// assigns an expression inside as many parentheses, to stress the tree walks
+// of wlp4parse and wlp4gen.
+string syntheticTokens(int statements, int nesting) {
+  string tokens =
+      "INT int\nWAIN wain\nLPAREN (\nINT int\nID a\nCOMMA ,\nINT int\n"
+      "ID b\nRPAREN )\nLBRACE {\nINT int\nID c\nBECOMES =\nNUM 0\n"
+      "SEMI ;\n";
+  const char *statement[] = {
+      // c = c + a * (b - 1);
+      "ID c\nBECOMES =\nID c\nPLUS +\nID a\nSTAR *\nLPAREN (\nID b\n"
+      "MINUS -\nNUM 1\nRPAREN )\nSEMI ;\n",
+      // if (c < a) { c = c - 1; } else { println(c); }
+      "IF if\nLPAREN (\nID c\nLT <\nID a\nRPAREN )\nLBRACE {\nID c\n"
+      "BECOMES =\nID c\nMINUS -\nNUM 1\nSEMI ;\nRBRACE }\nELSE else\n"
+      "LBRACE {\nPRINTLN println\nLPAREN (\nID c\nRPAREN )\nSEMI ;\n"
+      "RBRACE }\n",
+      // while (c >= b) { c = c / 2 % b; }
+      "WHILE while\nLPAREN (\nID c\nGE >=\nID b\nRPAREN )\nLBRACE {\n"
+      "ID c\nBECOMES =\nID c\nSLASH /\nNUM 2\nPCT %\nID b\nSEMI ;\n"
+      "RBRACE }\n"};
+  for (int i = 0; i < statements; i++) {
+    tokens += statement[i % 3];
   }
-
-  if (nonTerminal[root->val]) {
-    cout << root->val << " ";
-    for (int i = 0; i < root->children.size(); i++) {
-      cout << root->children[i]->val << " ";
+  if (nesting > 0) {
+    string ifs, lparens, rparens, elses;
+    for (int i = 0; i < nesting; i++) {
+      ifs += "IF if\nLPAREN (\nID c\nLT <\nID a\nRPAREN )\nLBRACE {\n";
+      lparens += "LPAREN (\n";
+      rparens += "RPAREN )\n";
+      elses += "RBRACE }\nELSE else\nLBRACE {\nRBRACE }\n";
     }
-    cout << endl;
-  } else {
-    cout << root->val << " " << root->lexeme << endl;
+    // c = ((...(c - 1)...));
+    tokens += ifs + "ID c\nBECOMES =\n" + lparens + "ID c\nMINUS -\nNUM 1\n" +
+              rparens + "SEMI ;\n" + elses;
   }
+  return tokens + "RETURN return\nID c\nSEMI ;\nRBRACE }\n";
 }
 
-TreeNode *buildFromLR(vector<TreeNode *> sequence) {
-  stack<int> stateStack;
-  stack<TreeNode *> treeStack;
-
-  // push start state
-  stateStack.push(0);
-  for (int i = 0; i < sequence.size(); i++) {
-    while (action[stateStack.top()][sequence[i]->val].first == "reduce") {
-      pair<string, vector<string>> r =
-          rule[action[stateStack.top()][sequence[i]->val].second];
-
-      TreeNode *newNode = new TreeNode(r.first);
-      stack<TreeNode *> temp;
-      for (int j = 0; j < r.second.size(); j++) {
-        temp.push(treeStack.top());
-        treeStack.pop();
-        stateStack.pop();
-      }
-      while (!temp.empty()) {  // invert stack output
-        newNode->children.push_back(temp.top());
-        temp.pop();
+// Parses the tokens in source repeatedly with every engine and prints the
+// time each takes, along with the size of the table it runs on. Only the
+// parse itself is timed; every run gets freshly read leaves, the trees are
+// released afterwards, and the engines take turns so none gets a warmer heap.
+int runBenchmark(const Grammar &grammar, const SourceBuffer &source,
+                 int iterations) {
+  ParseEngines parsers(grammar);
+  struct Engine {
+    const char *name;
+    size_t tableBytes;
+    unique_ptr<ParseTree> firstTree;
+    double best, total;
+  } engines[] = {
+      {"table",
+       size_t(grammar.numStates()) * (grammar.numSymbols() + 1) *
+           sizeof(uint32_t),
+       nullptr, 0, 0},
+      {"compressed", CompressedTable(grammar).bytes(), nullptr, 0, 0},
+      {"direct", 0, nullptr, 0, 0}};
+
+  // Every run after the first parses into the same tree, released in
+  // between, so its lexemes are already interned.
+  ParseTree scratch;
+  internGrammarKinds(grammar, scratch);
+  size_t numTokens = readCode(grammar, source, scratch).size();
+  scratch.release();
+
+  for (int i = 0; i < iterations; i++) {
+    for (Engine &engine : engines) {
+      if (i == 0) {
+        engine.firstTree.reset(new ParseTree());
+        internGrammarKinds(grammar, *engine.firstTree);
       }
-      if (debug) {
-        cout << stateStack.top() << " " << sequence[i]->val << " reduce "
-             << action[stateStack.top()][sequence[i]->val].first << " "
-             << action[stateStack.top()][sequence[i]->val].second << endl;
-      }
-      treeStack.push(newNode);
-      stateStack.push(action[stateStack.top()][treeStack.top()->val].second);
-    }
-    treeStack.push(sequence[i]);
-
-    // Reject if no suitable transition
-    if (action[stateStack.top()][sequence[i]->val].first != "shift") {
-      // Since BOF is not present in the input, it is not counted as a token
-      // when determining the length of the longest correct prefix.
-      cerr << "ERROR at " << i << endl;
-
-      // cleanup stateStack
-      while (!treeStack.empty()) {
-        deleteTree(treeStack.top());
-        treeStack.pop();
+      ParseTree &tree = i == 0 ? *engine.firstTree : scratch;
+      vector<TreeNode *> sequence = readCode(grammar, source, tree);
+      auto begin = chrono::steady_clock::now();
+      tree.root = parsers.parse(engine.name, tree, sequence);
+      chrono::duration<double, milli> elapsed =
+          chrono::steady_clock::now() - begin;
+
+      if (!tree.root) {
+        return 1;  // the engine has already reported the error
       }
-
-      // cleanup sequence
-      for (int j = i + 1; j < sequence.size(); j++) {
-        deleteTree(sequence[j]);
+      if (i > 0) {
+        scratch.release();
       }
-      sequence.clear();
-
-      return nullptr;
+      engine.best = i == 0 ? elapsed.count() : min(engine.best, elapsed.count());
+      engine.total += elapsed.count();
     }
-
-    if (debug) {
-      cout << stateStack.top() << " " << sequence[i]->val << " shift "
-           << action[stateStack.top()][sequence[i]->val].first << " "
-           << action[stateStack.top()][sequence[i]->val].second << endl;
-    }
-    stateStack.push(action[stateStack.top()][sequence[i]->val].second);
   }
 
-  // accept
-  // Note that there is no reduce action for rule 0 in the LR(1) DFA, even
-  // though you are required to output the rule corresponding to this final
-  // reduction in your parser. Rule 0 will always be the unique rule which has
-  // the start symbol on the LHS.
-  pair<string, vector<string>> r = rule[0];
-
-  TreeNode *newNode = new TreeNode(r.first);
-  stack<TreeNode *> temp;
-  for (int j = 0; j < r.second.size(); j++) {
-    temp.push(treeStack.top());
-    treeStack.pop();
-    stateStack.pop();
+  cout << "tokens: " << numTokens << ", tree "
+       << engines[0].firstTree->nodeBytes() << " bytes" << endl;
+  bool same = true;
+  for (Engine &engine : engines) {
+    cout << engine.name << ": best " << engine.best << " ms, mean "
+         << engine.total / iterations << " ms, "
+         << numTokens / engine.best / 1000 << " Mtokens/s";
+    if (engine.tableBytes) {
+      cout << ", table " << engine.tableBytes << " bytes";
+    }
+    cout << endl;
+    same = same && sameTree(*engines[0].firstTree, engines[0].firstTree->root,
+                            *engine.firstTree, engine.firstTree->root);
   }
-  while (!temp.empty()) {  // invert stack output
-    newNode->children.push_back(temp.top());
-    temp.pop();
+  if (!same) {
+    cerr << "ERROR: the engines built different trees" << endl;
+    return 1;
   }
-  treeStack.push(newNode);
-
-  return treeStack.top();
+  return 0;
 }
 
-void printToPreOrder(TreeNode *root) {
-  if (!root) {
-    return;
+/*
+ * Usage:
+ *   wlp4parse [--grammar file] [--engine=table|compressed|direct] [--binary]
+ *             [--trace] < tokens
+ *   wlp4parse --bench [--synthetic statements [--nesting depth]] < tokens
+ *   wlp4parse --synthetic statements [--nesting depth] | wlp4gen
+ *   wlp4parse [--grammar file] --compile-grammar > WLP4.lr1.bin
+ *   wlp4parse --grammar WLP4.lr1 --emit-tables > wlp4parse/wlp4Tables.h
+ *   wlp4parse --grammar WLP4.lr1 --emit-direct > wlp4parse/wlp4Direct.cc
+ *   wlp4parse --grammar WLP4.lr1 --emit-rules > common/wlp4Rules.h
+ *
+ * Without --grammar the WLP4 grammar compiled into the program is used, so
+ * nothing is read but the tokens. The grammar file may be WLP4.lr1 text or
+ * an image written by --compile-grammar; see grammar.h.
+ *
+ * The table engine (buildFromLR, see parseEngine.h) interprets the dense action table, the
+ * compressed engine runs buildFromLR on a CompressedTable, and the direct
+ * engine runs the parser generated into wlp4Direct.cc, which only works with
+ * the grammar it was generated from. --bench times all three on the input;
+ * --synthetic replaces the input with a generated program of the given
+ * number of statements, and --nesting adds one nested that deep; piped into
+ * wlp4gen, they make stress tests of any size.
+ *
+ * The tree is written as preorder text, or with --binary in the format of
+ * treeStream.h, which is cheaper both to write and to read. --trace writes
+ * every shift and reduce of the table engines to standard error.
+ */
+int main(int argc, char *argv[]) {
+  Grammar grammar;
+  string grammarPath;
+  bool compileGrammar = false;
+  bool emitTablesHeader = false;
+  bool emitDirect = false;
+  bool emitRuleEnum = false;
+  bool bench = false;
+  bool binary = false;
+  bool trace = false;
+  string engine = "table";
+  int synthetic = 0;
+  int nesting = 0;
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "--grammar" && i + 1 < argc) {
+      grammarPath = argv[++i];
+    } else if (arg == "--compile-grammar") {
+      compileGrammar = true;
+    } else if (arg == "--emit-tables") {
+      emitTablesHeader = true;
+    } else if (arg == "--emit-direct") {
+      emitDirect = true;
+    } else if (arg == "--emit-rules") {
+      emitRuleEnum = true;
+    } else if (arg == "--bench") {
+      bench = true;
+    } else if (arg == "--binary") {
+      binary = true;
+    } else if (arg == "--trace") {
+      trace = true;
+    } else if (arg == "--engine=table" || arg == "--engine=compressed" ||
+               arg == "--engine=direct") {
+      engine = arg.substr(arg.find('=') + 1);
+    } else if (arg == "--synthetic" && i + 1 < argc) {
+      synthetic = atoi(argv[++i]);
+    } else if (arg == "--nesting" && i + 1 < argc) {
+      nesting = atoi(argv[++i]);
+    } else {
+      cerr << "Usage: " << argv[0]
+           << " [--grammar file] [--engine=table|compressed|direct]"
+              " [--binary] [--trace] [--bench]"
+              " [--synthetic statements [--nesting depth]]"
+              " [--compile-grammar | --emit-tables | --emit-direct |"
+              " --emit-rules] < tokens"
+           << endl;
+      return 1;
+    }
   }
-
-  if (nonTerminal[root->val]) {
-    cout << root->val << " ";
-    for (int i = 0; i < root->children.size(); i++) {
-      cout << root->children[i]->val << " ";
+  try {
+    if (grammarPath.empty()) {
+      grammar.loadEmbedded();
+    } else {
+      grammar.load(grammarPath);
     }
-    cout << endl;
-  } else {
-    cout << root->val << " " << root->lexeme << endl;
+  } catch (runtime_error &e) {
+    cerr << "ERROR: " << e.what() << endl;
+    return 1;
   }
 
-  for (int i = 0; i < root->children.size(); i++) {
-    printToPreOrder(root->children[i]);
+  if (compileGrammar) {
+    cout.write(grammar.image().data(), grammar.image().size());
+    return 0;
+  }
+  if (emitTablesHeader) {
+    emitTables(grammar, cout);
+    return 0;
+  }
+  if (emitDirect) {
+    emitDirectParser(grammar, cout);
+    return 0;
+  }
+  if (emitRuleEnum) {
+    emitRules(grammar, cout);
+    return 0;
+  }
+  if ((engine == "direct" || bench) &&
+      grammar.imageChecksum() != DIRECT_GRAMMAR_CHECKSUM) {
+    cerr << "ERROR: the direct parser was generated from a different grammar"
+         << endl;
+    return 1;
   }
-}
-
-int main() {
-  fstream wlp4grammar;
-  wlp4grammar.open("WLP4.lr1");
-  recordGrammar(wlp4grammar);
 
+  unique_ptr<SourceBuffer> source(
+      synthetic > 0 ? new SourceBuffer(syntheticTokens(synthetic, nesting))
+                    : new SourceBuffer(STDIN_FILENO));
+  ParseTree tree;
+  internGrammarKinds(grammar, tree);
   vector<TreeNode *> sequence;
-  sequence = readCode();
+  try {
+    if (bench) {
+      return runBenchmark(grammar, *source, 10);
+    }
+    sequence = readCode(grammar, *source, tree);
+  } catch (runtime_error &e) {
+    cerr << "ERROR: " << e.what() << endl;
+    return 1;
+  }
 
-  TreeNode *top = buildFromLR(sequence);
-  printToPreOrder(top);
-  deleteTree(top);
+  ParseEngines parsers(grammar, trace ? &cerr : nullptr);
+  tree.root = parsers.parse(engine, tree, sequence);
+  if (binary) {
+    string stream = writeTreeStream(tree, tree.root, grammar.imageChecksum());
+    cout.write(stream.data(), stream.size());
+  } else {
+    printPreOrder(grammar, tree, tree.root, cout);
+  }
 }
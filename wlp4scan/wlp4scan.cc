@@ -1,24 +1,56 @@
+#include <unistd.h>
+
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <vector>
 
-#include "scanner.h"
+#include "sourceBuffer.h"
+#include "threadPool.h"
+#include "wlp4scanner.h"
 using namespace std;
 
 /*
- * All code requires C++14, so if you're getting compile errors make sure to
- * use -std=c++14.
+ * All code requires C++17, so if you're getting compile errors make sure to
+ * use -std=c++17.
+ *
+ * Reads a whole WLP4 program from standard input and prints one
+ * "KIND lexeme" line per token, which is the input format of wlp4parse.
+ * With --binary the tokens are written in the binary format described in
+ * tokenStream.h instead, which wlp4parse also accepts. With --threads N
+ * large inputs are scanned in N parallel chunks; the output is the same.
  */
-int main() {
-    string line;
-    try {
-        while (getline(cin, line)) {
-            vector<Token> tokenLine = scan(line);
+int main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(false);
+
+    bool binary = false;
+    size_t numThreads = 1;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--binary") {
+            binary = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            numThreads = strtoul(argv[++i], nullptr, 10);
+        } else {
+            cerr << "Usage: " << argv[0]
+                 << " [--binary] [--threads N] < program.wlp4" << endl;
+            return 1;
+        }
+    }
+
+    SourceBuffer source(STDIN_FILENO);
 
-            for (auto &token : tokenLine) {
-                cout << token << endl;
-            }
+    try {
+        vector<WLP4Token> tokens;
+        if (numThreads > 1) {
+            ThreadPool pool(numThreads);
+            tokens = scanWLP4(source.view(), pool);
+        } else {
+            tokens = scanWLP4(source.view());
         }
+
+        string output = writeTokens(source.view(), tokens, binary);
+        cout.write(output.data(), output.size());
     } catch (ScanningFailure &f) {
         std::cerr << f.what() << std::endl;
         return 1;
@@ -0,0 +1,365 @@
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <utility>
+
+#include "dfaTable.h"
+#include "parallelScan.h"
+#include "scanSimd.h"
+#include "tokenStream.h"
+#include "wlp4scanner.h"
+
+/*
+ * All code requires C++17, so if you're getting compile errors make sure to
+ * use -std=c++17.
+ *
+ * The DFA below follows the same layout as AsmDFA in scanner.cc: a dense
+ * transition table indexed by state and character, built at compile time,
+ * and a simplified maximal munch driver on top of it. Keywords are scanned as
+ * identifiers and reclassified afterwards, which keeps the DFA small.
+ */
+
+WLP4Token::WLP4Token(WLP4Token::Kind kind, std::string_view lexeme):
+  kind(kind), lexeme(lexeme) {}
+
+WLP4Token::Kind WLP4Token::getKind() const { return kind; }
+std::string_view WLP4Token::getLexeme() const { return lexeme; }
+
+const char *WLP4Token::kindName(WLP4Token::Kind kind) {
+  switch (kind) {
+    case ID:         return "ID";
+    case NUM:        return "NUM";
+    case LPAREN:     return "LPAREN";
+    case RPAREN:     return "RPAREN";
+    case LBRACE:     return "LBRACE";
+    case RBRACE:     return "RBRACE";
+    case RETURN:     return "RETURN";
+    case IF:         return "IF";
+    case ELSE:       return "ELSE";
+    case WHILE:      return "WHILE";
+    case PRINTLN:    return "PRINTLN";
+    case WAIN:       return "WAIN";
+    case BECOMES:    return "BECOMES";
+    case INT:        return "INT";
+    case EQ:         return "EQ";
+    case NE:         return "NE";
+    case LT:         return "LT";
+    case GT:         return "GT";
+    case LE:         return "LE";
+    case GE:         return "GE";
+    case PLUS:       return "PLUS";
+    case MINUS:      return "MINUS";
+    case STAR:       return "STAR";
+    case SLASH:      return "SLASH";
+    case PCT:        return "PCT";
+    case COMMA:      return "COMMA";
+    case SEMI:       return "SEMI";
+    case NEW:        return "NEW";
+    case DELETE:     return "DELETE";
+    case LBRACK:     return "LBRACK";
+    case RBRACK:     return "RBRACK";
+    case AMP:        return "AMP";
+    case NULL_:      return "NULL";
+    case WHITESPACE: return "WHITESPACE";
+    case COMMENT:    return "COMMENT";
+  }
+  return "";
+}
+
+std::ostream &operator<<(std::ostream &out, const WLP4Token &tok) {
+  out << WLP4Token::kindName(tok.getKind()) << " " << tok.getLexeme();
+  return out;
+}
+
+/* Representation of the WLP4 DFA, used to handle the scanning process.
+ */
+class WLP4DFA {
+  public:
+    enum State {
+      // States that are also kinds
+      ID = 0,
+      NUM,
+      LPAREN,
+      RPAREN,
+      LBRACE,
+      RBRACE,
+      BECOMES,
+      EQ,
+      NE,
+      LT,
+      GT,
+      LE,
+      GE,
+      PLUS,
+      MINUS,
+      STAR,
+      SLASH,
+      PCT,
+      COMMA,
+      SEMI,
+      LBRACK,
+      RBRACK,
+      AMP,
+      WHITESPACE,
+      COMMENT,
+
+      // States that are not also kinds
+      FAIL,
+      START,
+      ZERO,
+      NOT,
+
+      // Should always be the final element in the enum.
+      LARGEST_STATE = NOT
+    };
+
+  private:
+    typedef DFATable<State, LARGEST_STATE + 1> Table;
+
+    // Transition function, accepting states, state-to-kind mapping and run
+    // classes, computed at compile time by buildTable().
+    static const Table table;
+
+    static constexpr Table buildTable() {
+      Table t(FAIL);
+
+      t.accept(ID, WLP4Token::ID);
+      t.accept(NUM, WLP4Token::NUM);
+      t.accept(ZERO, WLP4Token::NUM);
+      t.accept(LPAREN, WLP4Token::LPAREN);
+      t.accept(RPAREN, WLP4Token::RPAREN);
+      t.accept(LBRACE, WLP4Token::LBRACE);
+      t.accept(RBRACE, WLP4Token::RBRACE);
+      t.accept(BECOMES, WLP4Token::BECOMES);
+      t.accept(EQ, WLP4Token::EQ);
+      t.accept(NE, WLP4Token::NE);
+      t.accept(LT, WLP4Token::LT);
+      t.accept(GT, WLP4Token::GT);
+      t.accept(LE, WLP4Token::LE);
+      t.accept(GE, WLP4Token::GE);
+      t.accept(PLUS, WLP4Token::PLUS);
+      t.accept(MINUS, WLP4Token::MINUS);
+      t.accept(STAR, WLP4Token::STAR);
+      t.accept(SLASH, WLP4Token::SLASH);
+      t.accept(PCT, WLP4Token::PCT);
+      t.accept(COMMA, WLP4Token::COMMA);
+      t.accept(SEMI, WLP4Token::SEMI);
+      t.accept(LBRACK, WLP4Token::LBRACK);
+      t.accept(RBRACK, WLP4Token::RBRACK);
+      t.accept(AMP, WLP4Token::AMP);
+      t.accept(WHITESPACE, WLP4Token::WHITESPACE);
+      t.accept(COMMENT, WLP4Token::COMMENT);
+      // Non-accepting states are START and NOT
+
+      t.registerTransition(START, scansimd::RUN_ALPHA, ID);
+      t.registerTransition(ID, scansimd::RUN_ALNUM, ID);
+      t.registerTransition(START, "0", ZERO);
+      t.registerTransition(START, "123456789", NUM);
+      t.registerTransition(NUM, scansimd::RUN_DIGIT, NUM);
+      t.registerTransition(START, "(", LPAREN);
+      t.registerTransition(START, ")", RPAREN);
+      t.registerTransition(START, "{", LBRACE);
+      t.registerTransition(START, "}", RBRACE);
+      t.registerTransition(START, "[", LBRACK);
+      t.registerTransition(START, "]", RBRACK);
+      t.registerTransition(START, "=", BECOMES);
+      t.registerTransition(BECOMES, "=", EQ);
+      t.registerTransition(START, "!", NOT);
+      t.registerTransition(NOT, "=", NE);
+      t.registerTransition(START, "<", LT);
+      t.registerTransition(LT, "=", LE);
+      t.registerTransition(START, ">", GT);
+      t.registerTransition(GT, "=", GE);
+      t.registerTransition(START, "+", PLUS);
+      t.registerTransition(START, "-", MINUS);
+      t.registerTransition(START, "*", STAR);
+      t.registerTransition(START, "/", SLASH);
+      t.registerTransition(SLASH, "/", COMMENT);
+      t.registerTransition(COMMENT, scansimd::RUN_LINE, COMMENT);
+      t.registerTransition(START, "%", PCT);
+      t.registerTransition(START, ",", COMMA);
+      t.registerTransition(START, ";", SEMI);
+      t.registerTransition(START, "&", AMP);
+      t.registerTransition(START, scansimd::RUN_SPACE, WHITESPACE);
+      t.registerTransition(WHITESPACE, scansimd::RUN_SPACE, WHITESPACE);
+
+      return t;
+    }
+
+    /*
+     * Converts a state to a kind to allow construction of Tokens from States.
+     * Throws an exception if conversion is not possible.
+     */
+    WLP4Token::Kind stateToKind(State s) const {
+      if (table.kind[s] < 0) {
+        throw ScanningFailure("ERROR: Cannot convert state to kind.");
+      }
+      return static_cast<WLP4Token::Kind>(table.kind[s]);
+    }
+
+  public:
+    /* Tokenizes an entire input buffer according to the Simplified Maximal
+     * Munch scanning algorithm. Each lexeme is a view of the buffer from the
+     * start of the token to the current position, so nothing is copied.
+     *
+     * As in AsmDFA, runs of identifier, number, whitespace and comment
+     * characters are skipped with scansimd::skipRun rather than stepped
+     * through one transition at a time, and keepTrivia selects at compile
+     * time whether WHITESPACE and COMMENT tokens are produced.
+     */
+    template <bool keepTrivia>
+    std::vector<WLP4Token> simplifiedMaximalMunch(std::string_view input) const {
+      std::vector<WLP4Token> result;
+
+      const char *posn = input.data();
+      const char *end = posn + input.size();
+
+      while (posn < end) {
+        const char *tokenStart = posn;
+        State state = start();
+
+        while (posn < end) {
+          State next = transition(state, *posn);
+          if (failed(next)) {
+            break;
+          }
+          state = next;
+          posn = scansimd::skipRun(table.runClass[state], posn + 1, end);
+        }
+
+        if (!accept(state)) {
+          // Include the offending character, if any, in the message.
+          const char *last = posn < end ? posn + 1 : posn;
+          throw ScanningFailure(
+              "ERROR: Simplified maximal munch failed on input: " +
+              std::string(tokenStart, last));
+        }
+
+        if (keepTrivia || (state != WHITESPACE && state != COMMENT)) {
+          result.emplace_back(stateToKind(state),
+              std::string_view(tokenStart, posn - tokenStart));
+        }
+      }
+
+      return result;
+    }
+
+    /* Returns the state corresponding to following a transition
+     * from the given starting state on the given character,
+     * or a special fail state if the transition does not exist.
+     * Characters outside of ASCII never have a transition.
+     */
+    State transition(State state, char nextChar) const {
+      unsigned char c = nextChar;
+      return c < 128 ? table.transitionFunction[state][c] : FAIL;
+    }
+
+    /* Checks whether the state returned by transition
+     * corresponds to failure to transition.
+     */
+    bool failed(State state) const { return state == FAIL; }
+
+    /* Checks whether the state returned by transition
+     * is an accepting state.
+     */
+    bool accept(State state) const { return table.accepts(state); }
+
+    /* Returns the starting state of the DFA
+     */
+    State start() const { return START; }
+};
+
+constexpr WLP4DFA::Table WLP4DFA::table = WLP4DFA::buildTable();
+
+namespace {
+
+// Keywords are scanned as ID and then looked up here.
+const std::pair<const char *, WLP4Token::Kind> keywords[] = {
+    {"int", WLP4Token::INT},         {"wain", WLP4Token::WAIN},
+    {"if", WLP4Token::IF},           {"else", WLP4Token::ELSE},
+    {"while", WLP4Token::WHILE},     {"println", WLP4Token::PRINTLN},
+    {"return", WLP4Token::RETURN},   {"new", WLP4Token::NEW},
+    {"delete", WLP4Token::DELETE},   {"NULL", WLP4Token::NULL_}};
+
+WLP4Token::Kind keywordKind(std::string_view lexeme) {
+  for (auto &keyword : keywords) {
+    if (lexeme == keyword.first) {
+      return keyword.second;
+    }
+  }
+  return WLP4Token::ID;
+}
+
+// NUM must fit in a signed 32-bit integer. Compare digit strings rather
+// than converting so arbitrarily long inputs cannot overflow.
+bool numInRange(std::string_view lexeme) {
+  static const std::string_view maxNum = "2147483647";
+  if (lexeme.size() != maxNum.size()) {
+    return lexeme.size() < maxNum.size();
+  }
+  return lexeme <= maxNum;
+}
+
+}  // namespace
+
+std::vector<WLP4Token> munchWLP4(std::string_view input) {
+  const WLP4DFA theDFA;
+
+  // WHITESPACE and COMMENT tokens are dropped while scanning.
+  std::vector<WLP4Token> tokens = theDFA.simplifiedMaximalMunch<false>(input);
+  for (auto &token : tokens) {
+    if (token.getKind() == WLP4Token::ID) {
+      token = WLP4Token(keywordKind(token.getLexeme()), token.getLexeme());
+    }
+  }
+  return tokens;
+}
+
+void checkNumRanges(const std::vector<WLP4Token> &tokens) {
+  for (auto &token : tokens) {
+    if (token.getKind() == WLP4Token::NUM && !numInRange(token.getLexeme())) {
+      throw ScanningFailure("ERROR: NUM out of range: " +
+          std::string(token.getLexeme()));
+    }
+  }
+}
+
+std::vector<WLP4Token> scanWLP4(std::string_view input) {
+  std::vector<WLP4Token> tokens = munchWLP4(input);
+  checkNumRanges(tokens);
+  return tokens;
+}
+
+std::vector<WLP4Token> scanWLP4(std::string_view input, ThreadPool &pool) {
+  // Only the munch is done per chunk: range checking each chunk as it is
+  // scanned would report a bad NUM in an early chunk over a failed munch in
+  // a later one, the opposite of the serial scan.
+  std::vector<WLP4Token> tokens =
+      parallelScan<WLP4Token>(input, pool, munchWLP4);
+  checkNumRanges(tokens);
+  return tokens;
+}
+
+std::string writeTokens(std::string_view input,
+                        const std::vector<WLP4Token> &tokens, bool binary) {
+  std::string output;
+  if (binary) {
+    std::vector<std::string_view> kindNames;
+    for (int k = WLP4Token::ID; k <= WLP4Token::COMMENT; k++) {
+      kindNames.push_back(WLP4Token::kindName(static_cast<WLP4Token::Kind>(k)));
+    }
+    TokenStreamWriter writer(input, kindNames);
+    for (auto &token : tokens) {
+      writer.add(token.getKind(), token.getLexeme());
+    }
+    output = writer.finish();
+  } else {
+    for (auto &token : tokens) {
+      output += WLP4Token::kindName(token.getKind());
+      output += ' ';
+      output += token.getLexeme();
+      output += '\n';
+    }
+  }
+  return output;
+}
@@ -0,0 +1,116 @@
+#ifndef WLP4SCANNER_H
+#define WLP4SCANNER_H
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "scanner.h"
+
+/*
+ * All code requires C++17, so if you're getting compile errors make sure to
+ * use -std=c++17.
+ *
+ * Scanner for WLP4 source code. Unlike the MIPS scanner in scanner.h, which
+ * works one line at a time, the WLP4 scanner takes the whole program as a
+ * single buffer and tokenizes it in one pass. Errors are reported by throwing
+ * the same ScanningFailure used by the MIPS scanner.
+ */
+
+class WLP4Token;
+class ThreadPool;
+
+/* Scans an entire WLP4 program and produces a list of tokens.
+ *
+ * Whitespace and comments are dropped. Keywords are returned with their own
+ * kind (INT, WAIN, IF, ...) rather than as ID, and NUM tokens are checked to
+ * fit in a signed 32-bit integer. Lexemes are views into input, which must
+ * outlive the tokens (normally it is a SourceBuffer).
+ */
+std::vector<WLP4Token> scanWLP4(std::string_view input);
+
+/* Same as above, but splits input into newline-aligned chunks and scans
+ * them on the pool's threads (see parallelScan.h). The result, including
+ * which error is thrown, is identical to the serial scan.
+ */
+std::vector<WLP4Token> scanWLP4(std::string_view input, ThreadPool &pool);
+
+/* The two passes of scanWLP4, for callers that scan a program a piece at a
+ * time. munchWLP4 tokenizes input, keywords included, and throws only if the
+ * munch fails; checkNumRanges throws for the first NUM in tokens that is out
+ * of range. To report the same error as scanWLP4, a NUM out of range must
+ * not be reported until every piece has been munched.
+ */
+std::vector<WLP4Token> munchWLP4(std::string_view input);
+void checkNumRanges(const std::vector<WLP4Token> &tokens);
+
+/* Formats the tokens scanned from input as wlp4parse reads them: one
+ * "KIND lexeme" line per token, or with binary set the format described in
+ * tokenStream.h.
+ */
+std::string writeTokens(std::string_view input,
+                        const std::vector<WLP4Token> &tokens, bool binary);
+
+/* A scanned WLP4 token. The kinds match the terminals of the WLP4 grammar,
+ * so the name returned by kindName() is exactly what wlp4parse expects on
+ * each line of its input.
+ */
+class WLP4Token {
+  public:
+    enum Kind {
+      ID = 0,
+      NUM,
+      LPAREN,
+      RPAREN,
+      LBRACE,
+      RBRACE,
+      RETURN,
+      IF,
+      ELSE,
+      WHILE,
+      PRINTLN,
+      WAIN,
+      BECOMES,
+      INT,
+      EQ,
+      NE,
+      LT,
+      GT,
+      LE,
+      GE,
+      PLUS,
+      MINUS,
+      STAR,
+      SLASH,
+      PCT,
+      COMMA,
+      SEMI,
+      NEW,
+      DELETE,
+      LBRACK,
+      RBRACK,
+      AMP,
+      NULL_,  // NULL is a macro in C++, the printed name is still "NULL"
+      WHITESPACE,
+      COMMENT
+    };
+
+  private:
+    Kind kind;
+    std::string_view lexeme;
+
+  public:
+    WLP4Token(Kind kind, std::string_view lexeme);
+
+    Kind getKind() const;
+    std::string_view getLexeme() const;
+
+    // Returns the grammar terminal name of a kind, e.g. "BECOMES".
+    static const char *kindName(Kind kind);
+};
+
+/* Prints a token in the "KIND lexeme" form read by wlp4parse.
+ */
+std::ostream &operator<<(std::ostream &out, const WLP4Token &tok);
+
+#endif